@@ -290,6 +290,18 @@ void HelpEngineWrapper::setLastShownPages(const QStringList &lastShownPages)
     CollectionConfiguration::setLastShownPages(*d->m_helpEngine, lastShownPages);
 }
 
+const QStringList HelpEngineWrapper::lastShownPageTitles() const
+{
+    TRACE_OBJ
+    return CollectionConfiguration::lastShownPageTitles(*d->m_helpEngine);
+}
+
+void HelpEngineWrapper::setLastShownPageTitles(const QStringList &lastShownPageTitles)
+{
+    TRACE_OBJ
+    CollectionConfiguration::setLastShownPageTitles(*d->m_helpEngine, lastShownPageTitles);
+}
+
 const QStringList HelpEngineWrapper::lastZoomFactors() const
 {
     TRACE_OBJ
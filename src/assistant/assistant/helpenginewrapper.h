@@ -84,6 +84,8 @@ public:
     //       Perhaps also fill up missing elements automatically or assert.
     const QStringList lastShownPages() const;
     void setLastShownPages(const QStringList &lastShownPages);
+    const QStringList lastShownPageTitles() const;
+    void setLastShownPageTitles(const QStringList &lastShownPageTitles);
     const QStringList lastZoomFactors() const;
     void setLastZoomFactors(const QStringList &lastZoomFactors);
 
@@ -7,9 +7,17 @@
 #include "helpenginewrapper.h"
 #include "tracer.h"
 
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDateTime>
 #include <QtCore/QFileInfo>
+#include <QtCore/QFuture>
+#include <QtCore/QHash>
+#include <QtCore/QPromise>
+#include <QtCore/QRegularExpression>
 #include <QtCore/QStringBuilder>
 #include <QtCore/QTemporaryFile>
+#include <QtCore/QThreadPool>
+#include <QtCore/QThreadStorage>
 
 #include <QtGui/QDesktopServices>
 #if QT_CONFIG(clipboard)
@@ -22,9 +30,14 @@
 #include <QtWidgets/QVBoxLayout>
 
 #include <QtHelp/QHelpEngineCore>
+#include <QtHelp/qhelp_global.h>
+#include <QtHelp/private/qhelpdbreader_p.h>
 
 #include <qlitehtmlwidget.h>
 
+#include <memory>
+#include <utility>
+
 QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
@@ -68,7 +81,7 @@ const struct ExtensionMap {
     { nullptr, nullptr }
 };
 
-static QByteArray getData(const QUrl &url)
+static QUrl dataUrl(const QUrl &url)
 {
     // TODO: this is just a hack for Qt documentation
     // which decides to use a simpler CSS if the viewer does not have JavaScript
@@ -80,7 +93,12 @@ static QByteArray getData(const QUrl &url)
         path.replace(simpleCss, "/offline.css");
         actualUrl.setPath(path);
     }
+    return actualUrl;
+}
 
+static QByteArray getData(const QUrl &url)
+{
+    const QUrl actualUrl = dataUrl(url);
     if (actualUrl.isValid())
         return HelpEngineWrapper::instance().fileData(actualUrl);
 
@@ -89,9 +107,73 @@ static QByteArray getData(const QUrl &url)
                    : HelpViewerImpl::PageNotFoundMessage.arg(url.toString()).toUtf8();
 }
 
+/*
+    The images and style sheets of a page are read from the documentation
+    files on the threads of this pool while the page is being set up.
+    The help engine cannot be used from other threads, so each thread
+    reads through its own reader on the documentation file, which is
+    opened again if the file has been replaced.
+*/
+namespace {
+struct PrefetchReader
+{
+    QString filePath;
+    QDateTime lastModified;
+    std::unique_ptr<QHelpDBReader> reader;
+};
+} // namespace
+
+static QByteArray prefetchFileData(const QString &filePath, const QString &folderName,
+                                   const QString &fileName)
+{
+    static QThreadStorage<PrefetchReader *> readers;
+    if (!readers.hasLocalData())
+        readers.setLocalData(new PrefetchReader);
+    PrefetchReader *current = readers.localData();
+
+    const QDateTime lastModified = QFileInfo(filePath).lastModified();
+    if (!current->reader || current->filePath != filePath
+            || current->lastModified != lastModified) {
+        current->reader.reset();
+        auto reader = std::make_unique<QHelpDBReader>(
+                filePath, QHelpGlobal::uniquifyConnectionName("HelpViewerPrefetch"_L1, current),
+                nullptr);
+        if (!reader->init())
+            return {};
+        current->filePath = filePath;
+        current->lastModified = lastModified;
+        current->reader = std::move(reader);
+    }
+    return current->reader->fileData(folderName, fileName);
+}
+
+Q_GLOBAL_STATIC(QThreadPool, prefetchThreadPool)
+
+static void stopPrefetching()
+{
+    prefetchThreadPool()->clear();
+    prefetchThreadPool()->waitForDone();
+}
+
+static QThreadPool *prefetchPool()
+{
+    // Let the threads, and with them their readers, finish while the
+    // application still exists.
+    static const bool stopOnExit = (qAddPostRoutine(stopPrefetching), true);
+    Q_UNUSED(stopOnExit);
+    return prefetchThreadPool();
+}
+
+static QUrl prefetchKey(const QUrl &url)
+{
+    return url.adjusted(QUrl::RemoveFragment | QUrl::NormalizePathSegments);
+}
+
 class HelpViewerPrivate
 {
 public:
+    ~HelpViewerPrivate() { clearPrefetchedResources(); }
+
     struct HistoryItem
     {
         QUrl url;
@@ -102,12 +184,21 @@ public:
     void setSourceInternal(const QUrl &url, int *vscroll = nullptr, bool reload = false);
     void incrementZoom(int steps);
     void applyZoom(int percentage);
+    void loadDeferredSource();
+    void prefetchResources(const QUrl &pageUrl, const QByteArray &pageData);
+    void clearPrefetchedResources();
+    QByteArray resourceData(const QUrl &url) const;
 
     HelpViewer *q = nullptr;
     QLiteHtmlWidget *m_viewer = nullptr;
     std::vector<HistoryItem> m_backItems;
     std::vector<HistoryItem> m_forwardItems;
     int m_fontZoom = 100; // zoom percentage
+    // A page that is restored at startup is only loaded once it is shown.
+    QUrl m_deferredUrl;
+    QString m_deferredTitle;
+    // The images and style sheets of the current page, as requested by it.
+    QHash<QUrl, QFuture<QByteArray>> m_prefetchedResources;
 };
 
 HelpViewerPrivate::HistoryItem HelpViewerPrivate::currentHistoryItem() const
@@ -129,8 +220,11 @@ void HelpViewerPrivate::setSourceInternal(const QUrl &url, int *vscroll, bool re
     newUrlWithoutFragment.setFragment({});
 
     m_viewer->setUrl(resolvedUrl);
-    if (currentUrlWithoutFragment != newUrlWithoutFragment || reload)
-        m_viewer->setHtml(QString::fromUtf8(getData(resolvedUrl)));
+    if (currentUrlWithoutFragment != newUrlWithoutFragment || reload) {
+        const QByteArray data = getData(resolvedUrl);
+        prefetchResources(resolvedUrl, data);
+        m_viewer->setHtml(QString::fromUtf8(data));
+    }
     if (vscroll)
         m_viewer->verticalScrollBar()->setValue(*vscroll);
     else
@@ -143,6 +237,83 @@ void HelpViewerPrivate::setSourceInternal(const QUrl &url, int *vscroll, bool re
     emit q->titleChanged();
 }
 
+void HelpViewerPrivate::loadDeferredSource()
+{
+    if (!m_deferredUrl.isValid())
+        return;
+    const QUrl url = std::exchange(m_deferredUrl, QUrl());
+    m_deferredTitle.clear();
+    setSourceInternal(url);
+}
+
+/*
+    Starts reading the images and style sheets that \a pageData, the
+    HTML of \a pageUrl, refers to. Only the documentation file of the
+    URL's own namespace is read; resources that are not found there are
+    left to getData(), which also looks in other versions.
+*/
+void HelpViewerPrivate::prefetchResources(const QUrl &pageUrl, const QByteArray &pageData)
+{
+    clearPrefetchedResources();
+
+    static const QRegularExpression resourceReference(
+            uR"(<(?:img|link)\b[^>]*?\b(?:src|href)\s*=\s*["']([^"'#]+))"_s,
+            QRegularExpression::CaseInsensitiveOption);
+
+    const HelpEngineWrapper &helpEngine = HelpEngineWrapper::instance();
+    QHash<QString, QString> documentationFiles;
+    const QString html = QString::fromUtf8(pageData);
+    for (auto it = resourceReference.globalMatch(html); it.hasNext(); ) {
+        const QUrl key = prefetchKey(pageUrl.resolved(QUrl(it.next().captured(1))));
+        if (key.scheme() != "qthelp"_L1 || m_prefetchedResources.contains(key))
+            continue;
+
+        const QUrl url = dataUrl(key);
+        QString path = url.path();
+        if (path.startsWith(u'/'))
+            path.remove(0, 1);
+        const qsizetype slash = path.indexOf(u'/');
+        if (slash <= 0)
+            continue;
+
+        const QString nameSpace = url.authority();
+        auto file = documentationFiles.constFind(nameSpace);
+        if (file == documentationFiles.cend())
+            file = documentationFiles.insert(nameSpace, helpEngine.documentationFileName(nameSpace));
+        if (file->isEmpty())
+            continue;
+
+        auto promise = std::make_shared<QPromise<QByteArray>>();
+        m_prefetchedResources.insert(key, promise->future());
+        promise->start();
+        prefetchPool()->start([promise, filePath = *file, folderName = path.left(slash),
+                               fileName = path.mid(slash + 1)] {
+            if (!promise->isCanceled())
+                promise->addResult(prefetchFileData(filePath, folderName, fileName));
+            promise->finish();
+        });
+    }
+}
+
+void HelpViewerPrivate::clearPrefetchedResources()
+{
+    for (QFuture<QByteArray> &future : m_prefetchedResources)
+        future.cancel();
+    m_prefetchedResources.clear();
+}
+
+QByteArray HelpViewerPrivate::resourceData(const QUrl &url) const
+{
+    const auto it = m_prefetchedResources.constFind(prefetchKey(url));
+    if (it != m_prefetchedResources.cend()) {
+        QFuture<QByteArray> future = *it;
+        future.waitForFinished();
+        if (future.resultCount() > 0 && !future.result().isEmpty())
+            return future.result();
+    }
+    return getData(url);
+}
+
 void HelpViewerPrivate::incrementZoom(int steps)
 {
     const int incrementPercentage = 10 * steps; // 10 percent increase by single step
@@ -166,7 +337,7 @@ HelpViewer::HelpViewer(qreal zoom, QWidget *parent)
     auto layout = new QVBoxLayout;
     d->q = this;
     d->m_viewer = new QLiteHtmlWidget(this);
-    d->m_viewer->setResourceHandler([](const QUrl &url) { return getData(url); });
+    d->m_viewer->setResourceHandler([this](const QUrl &url) { return d->resourceData(url); });
     d->m_viewer->viewport()->installEventFilter(this);
     const int zoomPercentage = zoom == 0 ? 100 : zoom * 100;
     d->applyZoom(zoomPercentage);
@@ -227,16 +398,23 @@ qreal HelpViewer::scale() const
 
 QString HelpViewer::title() const
 {
+    if (d->m_deferredUrl.isValid())
+        return d->m_deferredTitle.isEmpty() ? d->m_deferredUrl.toString() : d->m_deferredTitle;
     return d->m_viewer->title();
 }
 
 QUrl HelpViewer::source() const
 {
+    if (d->m_deferredUrl.isValid())
+        return d->m_deferredUrl;
     return d->m_viewer->url();
 }
 
 void HelpViewer::reload()
 {
+    // A page that has not been loaded yet will be loaded fresh anyway.
+    if (d->m_deferredUrl.isValid())
+        return;
     doSetSource(source(), true);
 }
 
@@ -245,11 +423,33 @@ void HelpViewer::setSource(const QUrl &url)
     doSetSource(url, false);
 }
 
+/*
+    Sets \a url as the source of the viewer without loading it. Until
+    the viewer is shown for the first time, source() and title() return
+    \a url and \a title.
+*/
+void HelpViewer::setDeferredSource(const QUrl &url, const QString &title)
+{
+    d->m_deferredUrl = url;
+    d->m_deferredTitle = title;
+    if (isVisible())
+        d->loadDeferredSource();
+}
+
+void HelpViewer::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    d->loadDeferredSource();
+}
+
 void HelpViewer::doSetSource(const QUrl &url, bool reload)
 {
     if (launchWithExternalApp(url))
         return;
 
+    d->m_deferredUrl.clear();
+    d->m_deferredTitle.clear();
+
     d->m_forwardItems.clear();
     emit forwardAvailable(false);
     if (d->m_viewer->url().isValid()) {
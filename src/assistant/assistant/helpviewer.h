@@ -45,6 +45,7 @@ public:
     QUrl source() const;
     void reload();
     void setSource(const QUrl &url);
+    void setDeferredSource(const QUrl &url, const QString &title);
 
 #if QT_CONFIG(printer)
     void print(QPrinter *printer);
@@ -73,6 +74,9 @@ public slots:
     void forward();
     void backward();
 
+protected:
+    void showEvent(QShowEvent *event) override;
+
 signals:
     void titleChanged();
     void copyAvailable(bool yes);
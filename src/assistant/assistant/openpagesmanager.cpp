@@ -104,6 +104,9 @@ void OpenPagesManager::setupInitialPages(bool defaultCollection,
             QStringList zoomFactors = helpEngine.lastZoomFactors();
             while (zoomFactors.size() < pageCount)
                 zoomFactors.append(CollectionConfiguration::DefaultZoomFactor);
+            QStringList titles = helpEngine.lastShownPageTitles();
+            if (titles.size() != pageCount)
+                titles = QStringList(pageCount, QString());
             initialPage = helpEngine.lastTabPage();
             if (initialPage >= pageCount) {
                 qWarning("Initial page set to %d, maximum possible value is %d",
@@ -114,7 +117,8 @@ void OpenPagesManager::setupInitialPages(bool defaultCollection,
                 const QString &curFile = lastShownPageList.at(curPage);
                 if (helpEngine.findFile(curFile).isValid()
                     || curFile == "about:blank"_L1) {
-                    m_model->addPage(curFile, zoomFactors.at(curPage).toFloat());
+                    m_model->addDeferredPage(curFile, titles.at(curPage),
+                                             zoomFactors.at(curPage).toFloat());
                 } else if (curPage <= initialPage && initialPage > 0)
                     --initialPage;
             }
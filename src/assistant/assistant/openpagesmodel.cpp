@@ -42,6 +42,26 @@ QVariant OpenPagesModel::data(const QModelIndex &index, int role) const
 }
 
 HelpViewer *OpenPagesModel::addPage(const QUrl &url, qreal zoom)
+{
+    TRACE_OBJ
+    HelpViewer *page = insertPage(zoom);
+    page->setSource(url);
+    return page;
+}
+
+// The page is only loaded when it is shown; until then, it is listed
+// with the given title.
+HelpViewer *OpenPagesModel::addDeferredPage(const QUrl &url, const QString &title, qreal zoom)
+{
+    TRACE_OBJ
+    HelpViewer *page = insertPage(zoom);
+    page->setDeferredSource(url, title);
+    const QModelIndex &item = index(m_pages.size() - 1, 0);
+    emit dataChanged(item, item);
+    return page;
+}
+
+HelpViewer *OpenPagesModel::insertPage(qreal zoom)
 {
     TRACE_OBJ
     beginInsertRows(QModelIndex(), rowCount(), rowCount());
@@ -49,7 +69,6 @@ HelpViewer *OpenPagesModel::addPage(const QUrl &url, qreal zoom)
     connect(page, &HelpViewer::titleChanged, this, &OpenPagesModel::handleTitleChanged);
     m_pages << page;
     endInsertRows();
-    page->setSource(url);
     return page;
 }
 
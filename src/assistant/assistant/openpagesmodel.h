@@ -24,6 +24,7 @@ public:
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
 
     HelpViewer *addPage(const QUrl &url, qreal zoom = 0);
+    HelpViewer *addDeferredPage(const QUrl &url, const QString &title, qreal zoom);
     void removePage(int index);
     HelpViewer *pageAt(int index) const;
 
@@ -32,6 +33,7 @@ private slots:
 
 private:
     OpenPagesModel(QObject *parent);
+    HelpViewer *insertPage(qreal zoom);
 
 private:
     QList<HelpViewer *> m_pages;
@@ -7,6 +7,12 @@
 #include "qhelpfilterdata.h"
 #include "qhelplink.h"
 
+#if QT_CONFIG(future)
+#include <QtConcurrent/qtconcurrentrun.h>
+#include <QtCore/qfuture.h>
+#include <QtCore/qthread.h>
+#endif
+
 #include <QtCore/qdatastream.h>
 #include <QtCore/qdatetime.h>
 #include <QtCore/qdir.h>
@@ -80,9 +86,11 @@ bool QHelpCollectionHandler::isDBOpened() const
 
 void QHelpCollectionHandler::closeDB()
 {
+    clearRoutes();
     if (!m_query)
         return;
 
+    m_timeStampValidation.reset();
     m_query.reset();
     QSqlDatabase::removeDatabase(m_connectionName);
     m_connectionName.clear();
@@ -169,8 +177,13 @@ bool QHelpCollectionHandler::openCollectionFile()
         indexAndNamespaceFilterTablesMissing = tablesExist;
     }
 
-    const FileInfoList &docList = registeredDocumentations();
+    if (!upgradeFileNameIndexes()) {
+        emit error(tr("Cannot create index tables in file %1.").arg(collectionFile()));
+        return false;
+    }
+
     if (indexAndNamespaceFilterTablesMissing) {
+        const FileInfoList &docList = registeredDocumentations();
         for (const QHelpCollectionHandler::FileInfo &info : docList) {
             if (!registerIndexAndNamespaceFilterTables(info.namespaceName, true)) {
                 emit error(tr("Cannot register index tables in file %1.").arg(collectionFile()));
@@ -180,8 +193,70 @@ bool QHelpCollectionHandler::openCollectionFile()
         return true;
     }
 
+    startTimeStampValidation();
+    return true;
+}
+
+QString QHelpCollectionHandler::absoluteDocPath(const QString &fileName) const
+{
+    const QFileInfo fi(collectionFile());
+    return QDir::isAbsolutePath(fileName)
+            ? fileName
+            : QFileInfo(fi.absolutePath() + u'/' + fileName).absoluteFilePath();
+}
+
+/*
+    The registrations of the collection are checked against the
+    documentation files each time the collection is opened. The
+    collection is usable right away; the files are stat'ed concurrently
+    in the background, and the registrations are only updated, and
+    registrationsChanged() emitted, once that is done and if any of
+    them turned out to be outdated.
+*/
+struct QHelpCollectionHandler::TimeStampValidation
+{
+    // Entries whose files are being checked by checks, each of which
+    // returns the indices of the outdated entries in its range.
     QList<TimeStamp> timeStamps;
-    m_query->exec("SELECT NamespaceId, FolderId, FilePath, Size, TimeStamp FROM TimeStampTable"_L1);
+#if QT_CONFIG(future)
+    QList<QFuture<QList<qsizetype>>> checks;
+#endif
+    // Entries that are outdated regardless of their files.
+    QList<TimeStamp> outdated;
+};
+
+static QList<qsizetype> outdatedTimeStamps(const QStringList &filePaths,
+                                           const QList<QHelpCollectionHandler::TimeStamp> &timeStamps,
+                                           qsizetype from, qsizetype to)
+{
+    QList<qsizetype> outdated;
+    for (qsizetype i = from; i < to; ++i) {
+        const QHelpCollectionHandler::TimeStamp &timeStamp = timeStamps.at(i);
+        const QFileInfo fi(filePaths.at(i));
+        if (!fi.exists() || fi.size() != timeStamp.size
+                || fi.lastModified(QTimeZone::UTC) != timeStamp.timeStamp) {
+            outdated.append(i);
+        }
+    }
+    return outdated;
+}
+
+void QHelpCollectionHandler::startTimeStampValidation()
+{
+    auto validation = std::make_unique<TimeStampValidation>();
+    QStringList filePaths;
+    m_query->exec(
+        "SELECT "
+            "TimeStampTable.NamespaceId, "
+            "TimeStampTable.FolderId, "
+            "TimeStampTable.FilePath, "
+            "TimeStampTable.Size, "
+            "TimeStampTable.TimeStamp, "
+            "NamespaceTable.FilePath "
+        "FROM "
+            "TimeStampTable "
+        "LEFT JOIN NamespaceTable "
+            "ON NamespaceTable.Id = TimeStampTable.NamespaceId"_L1);
     while (m_query->next()) {
         TimeStamp timeStamp;
         timeStamp.namespaceId = m_query->value(0).toInt();
@@ -189,90 +264,91 @@ bool QHelpCollectionHandler::openCollectionFile()
         timeStamp.fileName    = m_query->value(2).toString();
         timeStamp.size        = m_query->value(3).toInt();
         timeStamp.timeStamp   = m_query->value(4).toDateTime();
-        timeStamps.append(timeStamp);
+        if (m_query->isNull(5) || m_query->value(5).toString() != timeStamp.fileName) {
+            validation->outdated.append(timeStamp);
+        } else {
+            filePaths.append(absoluteDocPath(timeStamp.fileName));
+            validation->timeStamps.append(timeStamp);
+        }
     }
 
-    QList<TimeStamp> toRemove;
-    for (const TimeStamp &timeStamp : timeStamps) {
-        if (!isTimeStampCorrect(timeStamp))
-            toRemove.append(timeStamp);
+    const qsizetype count = validation->timeStamps.size();
+#if QT_CONFIG(future)
+    const qsizetype checkCount = qMin(count, qsizetype(qMax(1, QThread::idealThreadCount())));
+    for (qsizetype i = 0; i < checkCount; ++i) {
+        validation->checks.append(QtConcurrent::run(outdatedTimeStamps, filePaths,
+                                                    validation->timeStamps,
+                                                    count * i / checkCount,
+                                                    count * (i + 1) / checkCount));
     }
 
+    if (!validation->checks.isEmpty()) {
+        QtFuture::whenAll(validation->checks.cbegin(), validation->checks.cend())
+                .then(this, [this](const QList<QFuture<QList<qsizetype>>> &) {
+                    finishTimeStampValidation();
+                });
+        m_timeStampValidation = std::move(validation);
+        return;
+    }
+#else
+    for (qsizetype index : outdatedTimeStamps(filePaths, validation->timeStamps, 0, count))
+        validation->outdated.append(validation->timeStamps.at(index));
+#endif
+
+    QTimer::singleShot(0, this, &QHelpCollectionHandler::finishTimeStampValidation);
+    m_timeStampValidation = std::move(validation);
+}
+
+/*
+    Updates the registrations that the pending validation found to be
+    outdated, waiting for it if necessary.
+*/
+void QHelpCollectionHandler::finishTimeStampValidation()
+{
+    if (!m_timeStampValidation || !m_query)
+        return;
+
+    const std::unique_ptr<TimeStampValidation> validation = std::move(m_timeStampValidation);
+    QList<TimeStamp> toRemove = validation->outdated;
+#if QT_CONFIG(future)
+    for (const QFuture<QList<qsizetype>> &check : std::as_const(validation->checks)) {
+        for (qsizetype index : check.result())
+            toRemove.append(validation->timeStamps.at(index));
+    }
+#endif
+
     // TODO: we may optimize when toRemove.size() == timeStamps.size().
     // In this case we remove all records from tables.
     Transaction transaction(m_connectionName);
-    for (const TimeStamp &timeStamp : toRemove) {
+    for (const TimeStamp &timeStamp : std::as_const(toRemove)) {
         if (!unregisterIndexTable(timeStamp.namespaceId, timeStamp.folderId)) {
             emit error(tr("Cannot unregister index tables in file %1.").arg(collectionFile()));
-            return false;
+            return;
         }
     }
     transaction.commit();
 
-    for (const QHelpCollectionHandler::FileInfo &info : docList) {
-        if (!hasTimeStampInfo(info.namespaceName)
-                && !registerIndexAndNamespaceFilterTables(info.namespaceName)) {
-            // we may have a doc registered without a timestamp
-            // and the doc may be missing currently
-            unregisterDocumentation(info.namespaceName);
-        }
-    }
-    return true;
-}
-
-QString QHelpCollectionHandler::absoluteDocPath(const QString &fileName) const
-{
-    const QFileInfo fi(collectionFile());
-    return QDir::isAbsolutePath(fileName)
-            ? fileName
-            : QFileInfo(fi.absolutePath() + u'/' + fileName).absoluteFilePath();
-}
-
-bool QHelpCollectionHandler::isTimeStampCorrect(const TimeStamp &timeStamp) const
-{
-    const QFileInfo fi(absoluteDocPath(timeStamp.fileName));
-
-    if (!fi.exists())
-        return false;
-
-    if (fi.size() != timeStamp.size)
-        return false;
-
-    if (fi.lastModified(QTimeZone::UTC) != timeStamp.timeStamp)
-        return false;
-
-    m_query->prepare("SELECT FilePath FROM NamespaceTable WHERE Id = ?"_L1);
-    m_query->bindValue(0, timeStamp.namespaceId);
-    if (!m_query->exec() || !m_query->next())
-        return false;
-
-    const QString oldFileName = m_query->value(0).toString();
-    m_query->clear();
-    if (oldFileName != timeStamp.fileName)
-        return false;
-
-    return true;
-}
-
-bool QHelpCollectionHandler::hasTimeStampInfo(const QString &nameSpace) const
-{
-    m_query->prepare(
-        "SELECT "
-            "TimeStampTable.NamespaceId "
-        "FROM "
-            "NamespaceTable, "
-            "TimeStampTable "
-        "WHERE NamespaceTable.Id = TimeStampTable.NamespaceId "
-        "AND NamespaceTable.Name = ? LIMIT 1"_L1);
-    m_query->bindValue(0, nameSpace);
-    if (!m_query->exec())
-        return false;
+    QStringList namespacesWithoutTimeStamp;
+    m_query->exec(
+        "SELECT Name FROM NamespaceTable "
+        "WHERE Id NOT IN (SELECT NamespaceId FROM TimeStampTable)"_L1);
+    while (m_query->next())
+        namespacesWithoutTimeStamp.append(m_query->value(0).toString());
 
-    if (!m_query->next())
-        return false;
+    for (const QString &nameSpace : std::as_const(namespacesWithoutTimeStamp)) {
+        // we may have a doc registered without a timestamp
+        // and the doc may be missing currently
+        if (!registerIndexAndNamespaceFilterTables(nameSpace))
+            unregisterDocumentation(nameSpace);
+    }
 
-    m_query->clear();
-    return true;
+    if (!toRemove.isEmpty() || !namespacesWithoutTimeStamp.isEmpty()) {
+        // The routes may have been loaded from the outdated registrations,
+        // and the cached reader may still have a replaced file open.
+        clearRoutes();
+        QMetaObject::invokeMethod(this, &QHelpCollectionHandler::registrationsChanged,
+                                  Qt::QueuedConnection);
+    }
 }
 
 void QHelpCollectionHandler::scheduleVacuum()
@@ -408,7 +484,8 @@ bool QHelpCollectionHandler::createTables(QSqlQuery *query)
             "FilterAttributeId INTEGER )"_L1,
         "CREATE TABLE SettingsTable ("
             "Key TEXT PRIMARY KEY, "
-            "Value BLOB )"_L1
+            "Value BLOB )"_L1,
+        "CREATE INDEX FolderNameIndex ON FolderTable (Name)"_L1
     };
 
     for (const QString &q : tables) {
@@ -441,6 +518,7 @@ bool QHelpCollectionHandler::recreateIndexAndNamespaceFilterTables(QSqlQuery *qu
             "Name TEXT, "
             "FileId INTEGER PRIMARY KEY, "
             "Title TEXT)"_L1,
+        "CREATE INDEX FileNameIndex ON FileNameTable (Name)"_L1,
         "CREATE TABLE IndexTable ("
             "Id INTEGER PRIMARY KEY, "
             "Name TEXT, "
@@ -501,6 +579,32 @@ bool QHelpCollectionHandler::recreateIndexAndNamespaceFilterTables(QSqlQuery *qu
     return true;
 }
 
+// Files are looked up by folder and file name. Collections created
+// before there were indexes for these may store file names with a
+// leading "./", which registration now removes, so those are cleaned
+// when the indexes are added.
+bool QHelpCollectionHandler::upgradeFileNameIndexes()
+{
+    m_query->exec("SELECT COUNT(*) FROM sqlite_master WHERE Type='index' "
+                  "AND (Name='FileNameIndex' OR Name='FolderNameIndex')"_L1);
+    if (m_query->next() && m_query->value(0).toInt() == 2)
+        return true;
+
+    const QStringList statements = {
+        "UPDATE FileNameTable SET Name = substr(Name, 3) WHERE Name LIKE './%'"_L1,
+        "CREATE INDEX IF NOT EXISTS FileNameIndex ON FileNameTable (Name)"_L1,
+        "CREATE INDEX IF NOT EXISTS FolderNameIndex ON FolderTable (Name)"_L1
+    };
+
+    Transaction transaction(m_connectionName);
+    for (const QString &q : statements) {
+        if (!m_query->exec(q))
+            return false;
+    }
+    transaction.commit();
+    return true;
+}
+
 QStringList QHelpCollectionHandler::customFilters() const
 {
     QStringList list;
@@ -657,11 +761,14 @@ bool QHelpCollectionHandler::setFilterData(const QString &filterName,
     if (!m_query->execBatch())
         return false;
 
+    m_filterNamespaces.clear();
     return true;
 }
 
 bool QHelpCollectionHandler::removeFilter(const QString &filterName)
 {
+    m_filterNamespaces.clear();
+
     m_query->prepare("SELECT FilterId FROM Filter WHERE Name = ?"_L1);
     m_query->bindValue(0, filterName);
     if (!m_query->exec())
@@ -837,6 +944,8 @@ bool QHelpCollectionHandler::registerDocumentation(const QString &fileName)
     if (!isDBOpened())
         return false;
 
+    finishTimeStampValidation();
+
     QHelpDBReader reader(fileName, QHelpGlobal::uniquifyConnectionName(
         "QHelpCollectionHandler"_L1, this), nullptr);
     if (!reader.init()) {
@@ -866,6 +975,9 @@ bool QHelpCollectionHandler::registerDocumentation(const QString &fileName)
     if (!registerIndexTable(reader.indexTable(), nsId, vfId, registeredDocumentation(ns).fileName))
         return false;
 
+    m_filterNamespaces.clear();
+    if (m_routesLoaded)
+        loadRoutes(nsId);
     return true;
 }
 
@@ -874,6 +986,8 @@ bool QHelpCollectionHandler::unregisterDocumentation(const QString &namespaceNam
     if (!isDBOpened())
         return false;
 
+    finishTimeStampValidation();
+
     m_query->prepare("SELECT Id FROM NamespaceTable WHERE Name = ?"_L1);
     m_query->bindValue(0, namespaceName);
     m_query->exec();
@@ -905,6 +1019,7 @@ bool QHelpCollectionHandler::unregisterDocumentation(const QString &namespaceNam
     m_query->bindValue(0, nsId);
     if (!m_query->exec())
         return false;
+    removeRoutes(nsId);
 
     m_query->prepare("DELETE FROM FolderTable WHERE NamespaceId = ?"_L1);
     m_query->bindValue(0, nsId);
@@ -947,25 +1062,7 @@ bool QHelpCollectionHandler::fileExists(const QUrl &url) const
     if (fileInfo.namespaceName.isEmpty())
         return false;
 
-    m_query->prepare(
-        "SELECT COUNT (DISTINCT NamespaceTable.Id) "
-        "FROM "
-            "FileNameTable, "
-            "NamespaceTable, "
-            "FolderTable "
-        "WHERE FolderTable.Name = ? "
-        "AND FileNameTable.Name = ? "
-        "AND FileNameTable.FolderId = FolderTable.Id "
-        "AND FolderTable.NamespaceId = NamespaceTable.Id"_L1);
-    m_query->bindValue(0, fileInfo.folderName);
-    m_query->bindValue(1, fileInfo.fileName);
-    if (!m_query->exec() || !m_query->next())
-        return false;
-
-    const int count = m_query->value(0).toInt();
-    m_query->clear();
-
-    return count;
+    return routeNamespace(fileInfo, QString()) >= 0;
 }
 
 static QString prepareFilterQuery(const QString &filterName)
@@ -1086,6 +1183,9 @@ static void bindFilterQuery(QSqlQuery *query, int startingBindPos, const QString
 QString QHelpCollectionHandler::namespaceForFile(const QUrl &url,
                                                  const QStringList &filterAttributes) const
 {
+    if (filterAttributes.isEmpty())
+        return namespaceForFile(url, QString());
+
     if (!isDBOpened())
         return {};
 
@@ -1149,49 +1249,183 @@ QString QHelpCollectionHandler::namespaceForFile(const QUrl &url,
     if (fileInfo.namespaceName.isEmpty())
         return {};
 
-    const QString filterlessQuery =
-        "SELECT DISTINCT "
-            "NamespaceTable.Name "
+    const int nsId = routeNamespace(fileInfo, filterName);
+    return nsId < 0 ? QString() : m_namespaceRoutes.value(nsId).name;
+}
+
+/*
+  Loads the registered documentation files and the files in them, or
+  only those of the namespace \a nsId.
+*/
+void QHelpCollectionHandler::loadRoutes(int nsId) const
+{
+    QString namespaceQuery =
+        "SELECT "
+            "NamespaceTable.Id, "
+            "NamespaceTable.Name, "
+            "NamespaceTable.FilePath, "
+            "VersionTable.Version "
+        "FROM NamespaceTable "
+        "LEFT JOIN VersionTable ON VersionTable.NamespaceId = NamespaceTable.Id"_L1;
+    QString fileQuery =
+        "SELECT "
+            "FolderTable.NamespaceId, "
+            "FolderTable.Name, "
+            "FileNameTable.Name "
         "FROM "
             "FileNameTable, "
-            "NamespaceTable, "
             "FolderTable "
-        "WHERE FolderTable.Name = ? "
-        "AND FileNameTable.Name = ? "
-        "AND FileNameTable.FolderId = FolderTable.Id "
-        "AND FolderTable.NamespaceId = NamespaceTable.Id"_L1;
+        "WHERE FileNameTable.FolderId = FolderTable.Id"_L1;
+    if (nsId >= 0) {
+        namespaceQuery += " WHERE NamespaceTable.Id = ?"_L1;
+        fileQuery += " AND FolderTable.NamespaceId = ?"_L1;
+    }
 
-    const QString filterQuery = filterlessQuery
-            + prepareFilterQuery(filterName);
+    m_query->prepare(namespaceQuery);
+    if (nsId >= 0)
+        m_query->bindValue(0, nsId);
+    if (m_query->exec()) {
+        while (m_query->next()) {
+            const int id = m_query->value(0).toInt();
+            const QString name = m_query->value(1).toString();
+            m_namespaceRoutes.insert(id, { name, m_query->value(2).toString(),
+                                           m_query->value(3).toString() });
+            m_namespaceIds.insert(name, id);
+        }
+    }
 
-    m_query->prepare(filterQuery);
-    m_query->bindValue(0, fileInfo.folderName);
-    m_query->bindValue(1, fileInfo.fileName);
-    bindFilterQuery(m_query.get(), 2, filterName);
+    m_query->prepare(fileQuery);
+    if (nsId >= 0)
+        m_query->bindValue(0, nsId);
+    if (m_query->exec()) {
+        while (m_query->next()) {
+            QList<int> &namespaces = m_fileRoutes[m_query->value(1).toString() + u'/'
+                                                  + m_query->value(2).toString()];
+            const int id = m_query->value(0).toInt();
+            if (!namespaces.contains(id))
+                namespaces.append(id);
+        }
+    }
+    m_query->clear();
+    m_routesLoaded = true;
+}
 
-    if (!m_query->exec())
-        return {};
+void QHelpCollectionHandler::removeRoutes(int nsId)
+{
+    if (m_readerNamespaceId == nsId) {
+        m_reader.reset();
+        m_readerNamespaceId = -1;
+    }
+    m_filterNamespaces.clear();
+    if (!m_routesLoaded)
+        return;
 
-    QStringList namespaceList;
-    while (m_query->next())
-        namespaceList.append(m_query->value(0).toString());
+    m_namespaceIds.remove(m_namespaceRoutes.take(nsId).name);
+    for (auto it = m_fileRoutes.begin(); it != m_fileRoutes.end();) {
+        it->removeOne(nsId);
+        if (it->isEmpty())
+            it = m_fileRoutes.erase(it);
+        else
+            ++it;
+    }
+}
 
-    if (namespaceList.isEmpty())
-        return {};
+void QHelpCollectionHandler::clearRoutes() const
+{
+    m_reader.reset();
+    m_readerNamespaceId = -1;
+    m_routesLoaded = false;
+    m_namespaceRoutes.clear();
+    m_namespaceIds.clear();
+    m_fileRoutes.clear();
+    m_filterNamespaces.clear();
+}
 
-    if (namespaceList.contains(fileInfo.namespaceName))
-        return fileInfo.namespaceName;
+/*
+  Returns the id of the namespace that \a fileInfo resolves to, among
+  those that pass the filter \a filterName, or -1 if there is none.
+  That is the namespace of \a fileInfo if it has the file, or else one
+  with the same version.
+*/
+int QHelpCollectionHandler::routeNamespace(const FileInfo &fileInfo,
+                                           const QString &filterName) const
+{
+    if (!m_routesLoaded)
+        loadRoutes();
 
-    const QString originalVersion = namespaceVersion(fileInfo.namespaceName);
+    const auto it = m_fileRoutes.constFind(fileInfo.folderName + u'/' + fileInfo.fileName);
+    if (it == m_fileRoutes.cend())
+        return -1;
 
-    for (const QString &ns : namespaceList) {
-        const QString nsVersion = namespaceVersion(ns);
-        if (originalVersion == nsVersion)
-            return ns;
+    QList<int> namespaces = *it;
+    if (!filterName.isEmpty()) {
+        const QSet<int> &filtered = filterNamespaces(filterName);
+        namespaces.removeIf([&filtered](int id) { return !filtered.contains(id); });
+    }
+    if (namespaces.isEmpty())
+        return -1;
+
+    const int originalId = m_namespaceIds.value(fileInfo.namespaceName, -1);
+    if (namespaces.contains(originalId))
+        return originalId;
+
+    const QString originalVersion = m_namespaceRoutes.value(originalId).version;
+    for (int id : std::as_const(namespaces)) {
+        if (m_namespaceRoutes.value(id).version == originalVersion)
+            return id;
     }
 
     // TODO: still, we may like to return the ns for the highest available version
-    return namespaceList.first();
+    return namespaces.first();
+}
+
+/*
+  Returns the ids of the namespaces that pass the filter \a filterName.
+  The filter is evaluated once, until filters or documentation change.
+*/
+const QSet<int> &QHelpCollectionHandler::filterNamespaces(const QString &filterName) const
+{
+    auto it = m_filterNamespaces.find(filterName);
+    if (it != m_filterNamespaces.end())
+        return *it;
+
+    QSet<int> namespaces;
+    m_query->prepare("SELECT NamespaceTable.Id FROM NamespaceTable WHERE 1 = 1"_L1
+                     + prepareFilterQuery(filterName));
+    bindFilterQuery(m_query.get(), 0, filterName);
+    if (m_query->exec()) {
+        while (m_query->next())
+            namespaces.insert(m_query->value(0).toInt());
+    }
+    m_query->clear();
+    return *m_filterNamespaces.insert(filterName, namespaces);
+}
+
+/*
+  Returns a reader for the documentation file of the namespace \a nsId.
+  The reader of the last file that was read is kept open, as pages are
+  mostly followed by the images and style sheets from the same file.
+*/
+QHelpDBReader *QHelpCollectionHandler::documentationReader(int nsId) const
+{
+    if (m_reader && m_readerNamespaceId == nsId)
+        return m_reader.get();
+
+    m_reader.reset();
+    m_readerNamespaceId = -1;
+
+    const QString fileName = m_namespaceRoutes.value(nsId).filePath;
+    auto reader = std::make_unique<QHelpDBReader>(
+            absoluteDocPath(fileName),
+            QHelpGlobal::uniquifyConnectionName(fileName,
+                                                const_cast<QHelpCollectionHandler *>(this)),
+            nullptr);
+    if (!reader->init())
+        return nullptr;
+
+    m_reader = std::move(reader);
+    m_readerNamespaceId = nsId;
+    return m_reader.get();
 }
 
 QStringList QHelpCollectionHandler::files(const QString &namespaceName,
@@ -1313,21 +1547,19 @@ QByteArray QHelpCollectionHandler::fileData(const QUrl &url) const
     if (!isDBOpened())
         return {};
 
-    const QString namespaceName = namespaceForFile(url, QString());
-    if (namespaceName.isEmpty())
-        return {};
-
     const FileInfo fileInfo = extractFileInfo(url);
+    if (fileInfo.namespaceName.isEmpty())
+        return {};
 
-    const FileInfo docInfo = registeredDocumentation(namespaceName);
-    const QString absFileName = absoluteDocPath(docInfo.fileName);
+    const int nsId = routeNamespace(fileInfo, QString());
+    if (nsId < 0)
+        return {};
 
-    QHelpDBReader reader(absFileName, QHelpGlobal::uniquifyConnectionName(
-                         docInfo.fileName, const_cast<QHelpCollectionHandler *>(this)), nullptr);
-    if (!reader.init())
+    QHelpDBReader *reader = documentationReader(nsId);
+    if (!reader)
         return {};
 
-    return reader.fileData(fileInfo.folderName, fileInfo.fileName);
+    return reader->fileData(fileInfo.folderName, fileInfo.fileName);
 }
 
 QStringList QHelpCollectionHandler::indicesForFilter(const QStringList &filterAttributes) const
@@ -1927,7 +2159,7 @@ bool QHelpCollectionHandler::registerIndexTable(const QHelpDBReader::IndexTable
     int newFileId = 0;
     for (const QHelpDBReader::FileItem &item : indexTable.fileItems) {
         fileFolderIds.append(vfId);
-        fileNames.append(item.name);
+        fileNames.append(QDir::cleanPath(item.name));
         fileTitles.append(item.title);
 
         for (const QString &filterAttribute : item.filterAttributes)
@@ -19,9 +19,13 @@
 #include "qhelplink.h"
 
 #include <QtCore/qdatetime.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qobject.h>
+#include <QtCore/qset.h>
 #include <QtCore/qstringlist.h>
 
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 class QHelpFilterData;
@@ -157,6 +161,7 @@ public:
 
 signals:
     void error(const QString &msg);
+    void registrationsChanged();
 
 private:
     // legacy stuff
@@ -175,6 +180,7 @@ private:
     bool createTables(QSqlQuery *query);
     void closeDB();
     bool recreateIndexAndNamespaceFilterTables(QSqlQuery *query);
+    bool upgradeFileNameIndexes();
     bool registerIndexAndNamespaceFilterTables(const QString &nameSpace,
                                                bool createDefaultVersionFilter = false);
     void createVersionFilter(const QString &version);
@@ -184,16 +190,42 @@ private:
                             int nsId, int vfId, const QString &fileName);
     bool unregisterIndexTable(int nsId, int vfId);
     QString absoluteDocPath(const QString &fileName) const;
-    bool isTimeStampCorrect(const TimeStamp &timeStamp) const;
-    bool hasTimeStampInfo(const QString &nameSpace) const;
+    void startTimeStampValidation();
+    void finishTimeStampValidation();
     void scheduleVacuum();
     void execVacuum();
 
+    // The registered documentation files and the files in them, kept in
+    // memory so that URLs can be resolved without querying the collection.
+    struct NamespaceRoute
+    {
+        QString name;
+        QString filePath;
+        QString version;
+    };
+    void loadRoutes(int nsId = -1) const;
+    void removeRoutes(int nsId);
+    void clearRoutes() const;
+    int routeNamespace(const FileInfo &fileInfo, const QString &filterName) const;
+    const QSet<int> &filterNamespaces(const QString &filterName) const;
+    QHelpDBReader *documentationReader(int nsId) const;
+
     QString m_collectionFile;
     QString m_connectionName;
     std::unique_ptr<QSqlQuery> m_query;
     bool m_vacuumScheduled = false;
     bool m_readOnly = true;
+
+    struct TimeStampValidation;
+    std::unique_ptr<TimeStampValidation> m_timeStampValidation;
+
+    mutable bool m_routesLoaded = false;
+    mutable QHash<int, NamespaceRoute> m_namespaceRoutes;
+    mutable QHash<QString, int> m_namespaceIds;
+    mutable QHash<QString, QList<int>> m_fileRoutes; // "folder/file" to namespace ids
+    mutable QHash<QString, QSet<int>> m_filterNamespaces;
+    mutable std::unique_ptr<QHelpDBReader> m_reader;
+    mutable int m_readerNamespaceId = -1;
 };
 
 QT_END_NAMESPACE
@@ -4,6 +4,7 @@
 #include "qhelpdbreader_p.h"
 #include "qhelp_global.h"
 
+#include <QtCore/qdir.h>
 #include <QtCore/qfile.h>
 #include <QtCore/qmap.h>
 #include <QtCore/qvariant.h>
@@ -47,6 +48,11 @@ bool QHelpDBReader::init()
 
     m_initDone = true;
     m_query.reset(new QSqlQuery(QSqlDatabase::database(m_uniqueId)));
+
+    // Files generated with the file name index store clean paths.
+    m_query->exec("SELECT COUNT(*) FROM sqlite_master WHERE Type='index' "
+                  "AND Name='FileNameIndex'"_L1);
+    m_hasFileNameIndex = m_query->next() && m_query->value(0).toInt() > 0;
     return true;
 }
 
@@ -369,24 +375,45 @@ QByteArray QHelpDBReader::fileData(const QString &virtualFolder,
         return ba;
 
     namespaceName();
-    m_query->prepare(
-        "SELECT "
-            "FileDataTable.Data "
-        "FROM "
-            "FileDataTable, "
-            "FileNameTable, "
-            "FolderTable, "
-            "NamespaceTable "
-        "WHERE FileDataTable.Id = FileNameTable.FileId "
-        "AND (FileNameTable.Name = ? OR FileNameTable.Name = ?) "
-        "AND FileNameTable.FolderId = FolderTable.Id "
-        "AND FolderTable.Name = ? "
-        "AND FolderTable.NamespaceId = NamespaceTable.Id "
-        "AND NamespaceTable.Name = ?"_L1);
-    m_query->bindValue(0, filePath);
-    m_query->bindValue(1, QString("./"_L1 + filePath));
-    m_query->bindValue(2, virtualFolder);
-    m_query->bindValue(3, m_namespace);
+    if (m_hasFileNameIndex) {
+        m_query->prepare(
+            "SELECT "
+                "FileDataTable.Data "
+            "FROM "
+                "FileDataTable, "
+                "FileNameTable, "
+                "FolderTable, "
+                "NamespaceTable "
+            "WHERE FileDataTable.Id = FileNameTable.FileId "
+            "AND FileNameTable.Name = ? "
+            "AND FileNameTable.FolderId = FolderTable.Id "
+            "AND FolderTable.Name = ? "
+            "AND FolderTable.NamespaceId = NamespaceTable.Id "
+            "AND NamespaceTable.Name = ?"_L1);
+        m_query->bindValue(0, QDir::cleanPath(filePath));
+        m_query->bindValue(1, virtualFolder);
+        m_query->bindValue(2, m_namespace);
+    } else {
+        // Older files may store file names with a leading "./".
+        m_query->prepare(
+            "SELECT "
+                "FileDataTable.Data "
+            "FROM "
+                "FileDataTable, "
+                "FileNameTable, "
+                "FolderTable, "
+                "NamespaceTable "
+            "WHERE FileDataTable.Id = FileNameTable.FileId "
+            "AND (FileNameTable.Name = ? OR FileNameTable.Name = ?) "
+            "AND FileNameTable.FolderId = FolderTable.Id "
+            "AND FolderTable.Name = ? "
+            "AND FolderTable.NamespaceId = NamespaceTable.Id "
+            "AND NamespaceTable.Name = ?"_L1);
+        m_query->bindValue(0, filePath);
+        m_query->bindValue(1, QString("./"_L1 + filePath));
+        m_query->bindValue(2, virtualFolder);
+        m_query->bindValue(3, m_namespace);
+    }
     m_query->exec();
     if (m_query->next() && m_query->isValid())
         ba = qUncompress(m_query->value(0).toByteArray());
@@ -15,6 +15,8 @@
 // We mean it.
 //
 
+#include "qhelp_global.h"
+
 #include <QtCore/qbytearray.h>
 #include <QtCore/qobject.h>
 #include <QtCore/qstringlist.h>
@@ -23,7 +25,7 @@ QT_BEGIN_NAMESPACE
 
 class QSqlQuery;
 
-class QHelpDBReader : public QObject
+class QHELP_EXPORT QHelpDBReader : public QObject
 {
     Q_OBJECT
 
@@ -88,6 +90,7 @@ private:
     QString qtVersionHeuristic() const;
 
     bool m_initDone = false;
+    bool m_hasFileNameIndex = false;
     QString m_dbName;
     QString m_uniqueId;
     QString m_error;
@@ -52,6 +52,11 @@ void QHelpEngineCorePrivate::init(const QString &collectionFile)
     collectionHandler.reset(new QHelpCollectionHandler(collectionFile, q));
     QObject::connect(collectionHandler.get(), &QHelpCollectionHandler::error, q,
                      [this](const QString &msg) { error = msg; });
+    QObject::connect(collectionHandler.get(), &QHelpCollectionHandler::registrationsChanged, q,
+                     [this] {
+                         emit q->setupStarted();
+                         emit q->setupFinished();
+                     });
     filterEngine->setCollectionHandler(collectionHandler.get());
     needsSetup = true;
 }
@@ -133,6 +138,10 @@ bool QHelpEngineCorePrivate::setup()
     \fn void QHelpEngineCore::setupFinished()
 
     This signal is emitted when the setup is complete.
+
+    Outdated documentation registrations are updated in the background
+    after setup. If any are updated, setupStarted() and setupFinished()
+    are emitted again.
 */
 
 /*!
@@ -3,6 +3,8 @@
 
 #include "collectionconfiguration.h"
 
+#include <QtCore/QUrl>
+
 #include <QtHelp/QHelpEngineCore>
 
 QT_BEGIN_NAMESPACE
@@ -27,6 +29,7 @@ namespace {
     const QString LastPageKey("LastTabPage"_L1);
     const QString LastRegisterTime("LastRegisterTime"_L1);
     const QString LastShownPagesKey("LastShownPages"_L1);
+    const QString LastShownPageTitlesKey("LastShownPageTitles"_L1);
     const QString LastZoomFactorsKey(
 #if defined(BROWSER_QTWEBKIT)
             "LastPagesZoomWebView"_L1
@@ -214,6 +217,28 @@ void CollectionConfiguration::setLastShownPages(QHelpEngineCore &helpEngine,
                               lastShownPages.join(ListSeparator));
 }
 
+// Titles are stored percent-encoded, so that they cannot contain the separator.
+const QStringList CollectionConfiguration::lastShownPageTitles(const QHelpEngineCore &helpEngine)
+{
+    const QString value = helpEngine.customValue(LastShownPageTitlesKey).toString();
+    if (value.isEmpty())
+        return {};
+    QStringList titles = value.split(ListSeparator);
+    for (QString &title : titles)
+        title = QUrl::fromPercentEncoding(title.toLatin1());
+    return titles;
+}
+
+void CollectionConfiguration::setLastShownPageTitles(QHelpEngineCore &helpEngine,
+                                                     const QStringList &lastShownPageTitles)
+{
+    QStringList titles;
+    titles.reserve(lastShownPageTitles.size());
+    for (const QString &title : lastShownPageTitles)
+        titles << QString::fromLatin1(QUrl::toPercentEncoding(title));
+    helpEngine.setCustomValue(LastShownPageTitlesKey, titles.join(ListSeparator));
+}
+
 const QStringList CollectionConfiguration::lastZoomFactors(const QHelpEngineCore &helpEngine)
 {
     return helpEngine.customValue(LastZoomFactorsKey).toString().
@@ -79,6 +79,9 @@ public:
     static const QStringList lastShownPages(const QHelpEngineCore &helpEngine);
     static void setLastShownPages(QHelpEngineCore &helpEngine,
                                   const QStringList &lastShownPages);
+    static const QStringList lastShownPageTitles(const QHelpEngineCore &helpEngine);
+    static void setLastShownPageTitles(QHelpEngineCore &helpEngine,
+                                       const QStringList &lastShownPageTitles);
     static const QStringList lastZoomFactors(const QHelpEngineCore &helpEngine);
     static void setLastZoomFactors(QHelpEngineCore &helPEngine,
                                    const QStringList &lastZoomFactors);
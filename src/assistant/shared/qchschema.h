@@ -0,0 +1,90 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef QCHSCHEMA_H
+#define QCHSCHEMA_H
+
+#include <QtCore/QLatin1String>
+#include <QtCore/QStringList>
+
+QT_BEGIN_NAMESPACE
+
+// The tables of a Qt compressed help (.qch) file. Shared by
+// qhelpgenerator and by QDoc, which can write .qch files directly.
+namespace QchSchema {
+
+inline QStringList createTableStatements()
+{
+    return QStringList()
+            << QLatin1String("CREATE TABLE NamespaceTable ("
+                             "Id INTEGER PRIMARY KEY,"
+                             "Name TEXT )")
+            << QLatin1String("CREATE TABLE FilterAttributeTable ("
+                             "Id INTEGER PRIMARY KEY, "
+                             "Name TEXT )")
+            << QLatin1String("CREATE TABLE FilterNameTable ("
+                             "Id INTEGER PRIMARY KEY, "
+                             "Name TEXT )")
+            << QLatin1String("CREATE TABLE FilterTable ("
+                             "NameId INTEGER, "
+                             "FilterAttributeId INTEGER )")
+            << QLatin1String("CREATE TABLE IndexTable ("
+                             "Id INTEGER PRIMARY KEY, "
+                             "Name TEXT, "
+                             "Identifier TEXT, "
+                             "NamespaceId INTEGER, "
+                             "FileId INTEGER, "
+                             "Anchor TEXT )")
+            << QLatin1String("CREATE TABLE IndexFilterTable ("
+                             "FilterAttributeId INTEGER, "
+                             "IndexId INTEGER )")
+            << QLatin1String("CREATE TABLE ContentsTable ("
+                             "Id INTEGER PRIMARY KEY, "
+                             "NamespaceId INTEGER, "
+                             "Data BLOB )")
+            << QLatin1String("CREATE TABLE ContentsFilterTable ("
+                             "FilterAttributeId INTEGER, "
+                             "ContentsId INTEGER )")
+            << QLatin1String("CREATE TABLE FileAttributeSetTable ("
+                             "Id INTEGER, "
+                             "FilterAttributeId INTEGER )")
+            << QLatin1String("CREATE TABLE FileDataTable ("
+                             "Id INTEGER PRIMARY KEY, "
+                             "Data BLOB )")
+            << QLatin1String("CREATE TABLE FileFilterTable ("
+                             "FilterAttributeId INTEGER, "
+                             "FileId INTEGER )")
+            << QLatin1String("CREATE TABLE FileNameTable ("
+                             "FolderId INTEGER, "
+                             "Name TEXT, "
+                             "FileId INTEGER, "
+                             "Title TEXT )")
+            << QLatin1String("CREATE TABLE FolderTable("
+                             "Id INTEGER PRIMARY KEY, "
+                             "Name Text, "
+                             "NamespaceID INTEGER )")
+            << QLatin1String("CREATE TABLE MetaDataTable("
+                             "Name Text, "
+                             "Value BLOB )");
+}
+
+// Files are looked up by folder and file name. The generators store
+// file names with QDir::cleanPath(), so a reader that finds these
+// indexes can look a file up by its clean path alone.
+inline QStringList createIndexStatements()
+{
+    return QStringList()
+            << QLatin1String("CREATE INDEX FileNameIndex ON FileNameTable (Name)")
+            << QLatin1String("CREATE INDEX FolderNameIndex ON FolderTable (Name)");
+}
+
+inline QLatin1String insertVersionStatement()
+{
+    return QLatin1String("INSERT INTO MetaDataTable VALUES('qchVersion', '1.0')");
+}
+
+} // namespace QchSchema
+
+QT_END_NAMESPACE
+
+#endif // QCHSCHEMA_H
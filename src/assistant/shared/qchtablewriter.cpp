@@ -0,0 +1,498 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "qchtablewriter.h"
+#include "qchschema.h"
+
+#include <QtCore/QDataStream>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QStringConverter>
+#include <QtSql/QSqlQuery>
+
+#include <QtHelp/qhelp_global.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+namespace {
+
+struct FileNameTableData
+{
+    QString name;
+    int fileId;
+    QString title;
+};
+
+} // namespace
+
+/*!
+    Constructs a writer that fills the tables of the database \a query
+    is open on. Files that cannot be read are reported to
+    \a warningHandler.
+*/
+QchTableWriter::QchTableWriter(QSqlQuery *query, WarningHandler warningHandler)
+    : m_query(query), m_warningHandler(std::move(warningHandler))
+{
+}
+
+bool QchTableWriter::createTables()
+{
+    if (!m_query)
+        return false;
+
+    m_query->exec("SELECT COUNT(*) FROM sqlite_master WHERE TYPE=\'table\'"
+                  "AND Name=\'NamespaceTable\'"_L1);
+    m_query->next();
+    if (m_query->value(0).toInt() > 0) {
+        m_error = tr("Some tables already exist.");
+        return false;
+    }
+
+    const QStringList tables = QchSchema::createTableStatements()
+            + QchSchema::createIndexStatements();
+    for (const QString &q : tables) {
+        if (!m_query->exec(q)) {
+            m_error = tr("Cannot create tables.");
+            return false;
+        }
+    }
+
+    m_query->exec(QchSchema::insertVersionStatement());
+
+    return true;
+}
+
+bool QchTableWriter::insertFileNotFoundFile()
+{
+    if (!m_query)
+        return false;
+
+    m_query->exec("SELECT id FROM FileNameTable WHERE Name=\'\'"_L1);
+    if (m_query->next() && m_query->isValid())
+        return true;
+
+    m_query->prepare("INSERT INTO FileDataTable VALUES (Null, ?)"_L1);
+    m_query->bindValue(0, QByteArray());
+    if (!m_query->exec())
+        return false;
+
+    const int fileId = m_query->lastInsertId().toInt();
+    m_query->prepare("INSERT INTO FileNameTable (FolderId, Name, FileId, Title) "
+                     " VALUES (0, '', ?, '')"_L1);
+    m_query->bindValue(0, fileId);
+    if (fileId > -1 && m_query->exec()) {
+        m_fileMap.insert({}, fileId);
+        return true;
+    }
+    return false;
+}
+
+bool QchTableWriter::insertMetaData(const QMap<QString, QVariant> &metaData)
+{
+    if (!m_query)
+        return false;
+
+    for (auto it = metaData.cbegin(), end = metaData.cend(); it != end; ++it) {
+        m_query->prepare("INSERT INTO MetaDataTable VALUES(?, ?)"_L1);
+        m_query->bindValue(0, it.key());
+        m_query->bindValue(1, it.value());
+        m_query->exec();
+    }
+    return true;
+}
+
+bool QchTableWriter::registerVirtualFolder(const QString &folderName, const QString &ns)
+{
+    if (!m_query || folderName.isEmpty() || ns.isEmpty())
+        return false;
+
+    m_query->prepare("SELECT Id FROM FolderTable WHERE Name=?"_L1);
+    m_query->bindValue(0, folderName);
+    m_query->exec();
+    m_query->next();
+    if (m_query->isValid() && m_query->value(0).toInt() > 0)
+        return true;
+
+    m_namespaceId = -1;
+    m_query->prepare("SELECT Id FROM NamespaceTable WHERE Name=?"_L1);
+    m_query->bindValue(0, ns);
+    m_query->exec();
+    while (m_query->next()) {
+        m_namespaceId = m_query->value(0).toInt();
+        break;
+    }
+
+    if (m_namespaceId < 0) {
+        m_query->prepare("INSERT INTO NamespaceTable VALUES(NULL, ?)"_L1);
+        m_query->bindValue(0, ns);
+        if (m_query->exec())
+            m_namespaceId = m_query->lastInsertId().toInt();
+    }
+
+    if (m_namespaceId > 0) {
+        m_query->prepare("SELECT Id FROM FolderTable WHERE Name=?"_L1);
+        m_query->bindValue(0, folderName);
+        m_query->exec();
+        while (m_query->next())
+            m_virtualFolderId = m_query->value(0).toInt();
+
+        if (m_virtualFolderId > 0)
+            return true;
+
+        m_query->prepare("INSERT INTO FolderTable (NamespaceId, Name) "
+                         "VALUES (?, ?)"_L1);
+        m_query->bindValue(0, m_namespaceId);
+        m_query->bindValue(1, folderName);
+        if (m_query->exec()) {
+            m_virtualFolderId = m_query->lastInsertId().toInt();
+            return m_virtualFolderId > 0;
+        }
+    }
+    m_error = tr("Cannot register virtual folder.");
+    return false;
+}
+
+/*!
+    Registers the custom filter \a filterName with the attributes
+    \a filterAttribs, replacing the attributes of a filter with the
+    same name.
+*/
+bool QchTableWriter::registerCustomFilter(const QString &filterName,
+                                          const QStringList &filterAttribs)
+{
+    if (!m_query)
+        return false;
+
+    m_query->exec("SELECT Id, Name FROM FilterAttributeTable"_L1);
+    QStringList idsToInsert = filterAttribs;
+    QMap<QString, int> attributeMap;
+    while (m_query->next()) {
+        attributeMap.insert(m_query->value(1).toString(),
+                            m_query->value(0).toInt());
+        idsToInsert.removeAll(m_query->value(1).toString());
+    }
+
+    for (const QString &id : std::as_const(idsToInsert)) {
+        m_query->prepare("INSERT INTO FilterAttributeTable VALUES(NULL, ?)"_L1);
+        m_query->bindValue(0, id);
+        m_query->exec();
+        attributeMap.insert(id, m_query->lastInsertId().toInt());
+    }
+
+    int nameId = -1;
+    m_query->prepare("SELECT Id FROM FilterNameTable WHERE Name=?"_L1);
+    m_query->bindValue(0, filterName);
+    m_query->exec();
+    while (m_query->next()) {
+        nameId = m_query->value(0).toInt();
+        break;
+    }
+
+    if (nameId < 0) {
+        m_query->prepare("INSERT INTO FilterNameTable VALUES(NULL, ?)"_L1);
+        m_query->bindValue(0, filterName);
+        if (m_query->exec())
+            nameId = m_query->lastInsertId().toInt();
+    }
+
+    if (nameId < 0) {
+        m_error = tr("Cannot register filter %1.").arg(filterName);
+        return false;
+    }
+
+    m_query->prepare("DELETE FROM FilterTable WHERE NameId=?"_L1);
+    m_query->bindValue(0, nameId);
+    m_query->exec();
+
+    for (const QString &att : filterAttribs) {
+        m_query->prepare("INSERT INTO FilterTable VALUES(?, ?)"_L1);
+        m_query->bindValue(0, nameId);
+        m_query->bindValue(1, attributeMap[att]);
+        if (!m_query->exec())
+            return false;
+    }
+    return true;
+}
+
+bool QchTableWriter::insertFilterAttributes(const QStringList &attributes)
+{
+    if (!m_query)
+        return false;
+
+    m_query->exec("SELECT Name FROM FilterAttributeTable"_L1);
+    QSet<QString> atts;
+    while (m_query->next())
+        atts.insert(m_query->value(0).toString());
+
+    for (const QString &s : attributes) {
+        if (!atts.contains(s)) {
+            m_query->prepare("INSERT INTO FilterAttributeTable VALUES(NULL, ?)"_L1);
+            m_query->bindValue(0, s);
+            m_query->exec();
+        }
+    }
+    return true;
+}
+
+/*!
+    Inserts the compressed contents and the titles of \a files, which
+    are relative to \a rootPath, and associates them with
+    \a filterAttributes. The contents are inserted as the files are
+    read, so only one file is held in memory at a time. Files that
+    cannot be read are skipped with a warning.
+*/
+bool QchTableWriter::insertFiles(const QStringList &files, const QString &rootPath,
+                                 const QStringList &filterAttributes)
+{
+    if (!m_query)
+        return false;
+
+    QSet<int> filterAtts;
+    for (const QString &filterAtt : filterAttributes) {
+        m_query->prepare("SELECT Id FROM FilterAttributeTable "
+                         "WHERE Name=?"_L1);
+        m_query->bindValue(0, filterAtt);
+        m_query->exec();
+        if (m_query->next())
+            filterAtts.insert(m_query->value(0).toInt());
+    }
+
+    int filterSetId = -1;
+    m_query->exec("SELECT MAX(Id) FROM FileAttributeSetTable"_L1);
+    if (m_query->next())
+        filterSetId = m_query->value(0).toInt();
+    if (filterSetId < 0)
+        return false;
+    ++filterSetId;
+    QList<int> attValues = filterAtts.values();
+    std::sort(attValues.begin(), attValues.end());
+    for (int attId : std::as_const(attValues)) {
+        m_query->prepare("INSERT INTO FileAttributeSetTable "
+                         "VALUES(?, ?)"_L1);
+        m_query->bindValue(0, filterSetId);
+        m_query->bindValue(1, attId);
+        m_query->exec();
+    }
+
+    int tableFileId = 1;
+    m_query->exec("SELECT MAX(Id) FROM FileDataTable"_L1);
+    if (m_query->next())
+        tableFileId = m_query->value(0).toInt() + 1;
+
+    QMap<int, QSet<int> > tmpFileFilterMap;
+    QList<FileNameTableData> fileNameDataList;
+
+    m_query->exec("BEGIN"_L1);
+    for (const QString &file : files) {
+        const QString fileName = QDir::cleanPath(file);
+
+        QFile fi(rootPath + QDir::separator() + fileName);
+        if (!fi.exists()) {
+            if (m_warningHandler) {
+                m_warningHandler(tr("The file %1 does not exist, skipping it...")
+                        .arg(QDir::cleanPath(rootPath + QDir::separator() + fileName)));
+            }
+            continue;
+        }
+
+        if (!fi.open(QIODevice::ReadOnly)) {
+            if (m_warningHandler) {
+                m_warningHandler(tr("Cannot open file %1, skipping it...")
+                        .arg(QDir::cleanPath(rootPath + QDir::separator() + fileName)));
+            }
+            continue;
+        }
+
+        const auto &it = m_fileMap.constFind(fileName);
+        if (it == m_fileMap.cend()) {
+            const QByteArray data = fi.readAll();
+            QString title;
+            if (fileName.endsWith(".html"_L1) || fileName.endsWith(".htm"_L1)) {
+                auto encoding = QStringDecoder::encodingForHtml(data);
+                if (!encoding)
+                    encoding = QStringDecoder::Utf8;
+                title = QHelpGlobal::documentTitle(QStringDecoder(*encoding)(data));
+            } else {
+                title = fileName.mid(fileName.lastIndexOf(u'/') + 1);
+            }
+
+            m_query->prepare("INSERT INTO FileDataTable VALUES "
+                             "(Null, ?)"_L1);
+            m_query->bindValue(0, qCompress(data));
+            m_query->exec();
+
+            fileNameDataList.append({ fileName, tableFileId, title });
+
+            m_fileMap.insert(fileName, tableFileId);
+            m_fileFilterMap.insert(tableFileId, filterAtts);
+            tmpFileFilterMap.insert(tableFileId, filterAtts);
+
+            ++tableFileId;
+        } else {
+            const int fileId = it.value();
+            QSet<int> &fileFilterSet = m_fileFilterMap[fileId];
+            QSet<int> &tmpFileFilterSet = tmpFileFilterMap[fileId];
+            for (int filter : std::as_const(filterAtts)) {
+                if (!fileFilterSet.contains(filter)
+                    && !tmpFileFilterSet.contains(filter)) {
+                    fileFilterSet.insert(filter);
+                    tmpFileFilterSet.insert(filter);
+                }
+            }
+        }
+    }
+
+    for (auto it = tmpFileFilterMap.cbegin(), end = tmpFileFilterMap.cend(); it != end; ++it) {
+        QList<int> filterValues = it.value().values();
+        std::sort(filterValues.begin(), filterValues.end());
+        for (int fv : std::as_const(filterValues)) {
+            m_query->prepare("INSERT INTO FileFilterTable "
+                             "VALUES(?, ?)"_L1);
+            m_query->bindValue(0, fv);
+            m_query->bindValue(1, it.key());
+            m_query->exec();
+        }
+    }
+
+    for (const FileNameTableData &fnd : std::as_const(fileNameDataList)) {
+        m_query->prepare("INSERT INTO FileNameTable "
+                         "(FolderId, Name, FileId, Title) VALUES (?, ?, ?, ?)"_L1);
+        m_query->bindValue(0, 1);
+        m_query->bindValue(1, fnd.name);
+        m_query->bindValue(2, fnd.fileId);
+        m_query->bindValue(3, fnd.title);
+        m_query->exec();
+    }
+    m_query->exec("COMMIT"_L1);
+
+    m_query->exec("SELECT MAX(Id) FROM FileDataTable"_L1);
+    return m_query->next() && m_query->value(0).toInt() == tableFileId - 1;
+}
+
+/*!
+    Inserts the table of contents \a contents, in which each entry
+    follows its parent, and associates it with \a filterAttributes.
+*/
+bool QchTableWriter::insertContents(const QList<ContentsEntry> &contents,
+                                    const QStringList &filterAttributes)
+{
+    if (!m_query)
+        return false;
+
+    QByteArray ba;
+    {
+        QDataStream s(&ba, QIODevice::WriteOnly);
+        for (const ContentsEntry &entry : contents)
+            s << entry.depth << entry.reference << entry.title;
+    }
+
+    m_query->prepare("INSERT INTO ContentsTable (NamespaceId, Data) "
+                     "VALUES(?, ?)"_L1);
+    m_query->bindValue(0, m_namespaceId);
+    m_query->bindValue(1, ba);
+    m_query->exec();
+    int contentId = m_query->lastInsertId().toInt();
+    if (contentId < 1) {
+        m_error = tr("Cannot insert contents.");
+        return false;
+    }
+
+    // associate the filter attributes
+    for (const QString &filterAtt : filterAttributes) {
+        m_query->prepare("INSERT INTO ContentsFilterTable (FilterAttributeId, ContentsId) "
+                         "SELECT Id, ? FROM FilterAttributeTable WHERE Name=?"_L1);
+        m_query->bindValue(0, contentId);
+        m_query->bindValue(1, filterAtt);
+        m_query->exec();
+        if (!m_query->isActive()) {
+            m_error = tr("Cannot register contents.");
+            return false;
+        }
+    }
+    return true;
+}
+
+/*!
+    Inserts \a keywords and associates them with \a filterAttributes.
+    Only the first keyword with a given identifier is kept, and keywords
+    that refer to a file that has not been inserted refer to the file
+    for missing files.
+*/
+bool QchTableWriter::insertKeywords(const QList<Keyword> &keywords,
+                                    const QStringList &filterAttributes)
+{
+    if (!m_query)
+        return false;
+
+    int indexId = 1;
+    m_query->exec("SELECT MAX(Id) FROM IndexTable"_L1);
+    if (m_query->next())
+        indexId = m_query->value(0).toInt() + 1;
+
+    QList<int> filterAtts;
+    for (const QString &filterAtt : filterAttributes) {
+        m_query->prepare("SELECT Id FROM FilterAttributeTable WHERE Name=?"_L1);
+        m_query->bindValue(0, filterAtt);
+        m_query->exec();
+        if (m_query->next())
+            filterAtts.append(m_query->value(0).toInt());
+    }
+
+    QList<int> indexFilterTable;
+
+    m_query->exec("BEGIN"_L1);
+    QSet<QString> indices;
+    for (const Keyword &itm : keywords) {
+         // Identical ids make no sense and just confuse the Assistant user,
+         // so we ignore all repetitions.
+        if (indices.contains(itm.identifier))
+            continue;
+
+        // Still empty ids should be ignored, as otherwise we will include only
+        // the first keyword with an empty id.
+        if (!itm.identifier.isEmpty())
+            indices.insert(itm.identifier);
+
+        const int pos = itm.reference.indexOf(u'#');
+        const QString &fileName = itm.reference.left(pos);
+        const QString anchor = pos < 0 ? QString() : itm.reference.mid(pos + 1);
+
+        const QString &fName = QDir::cleanPath(fileName);
+
+        const auto &it = m_fileMap.constFind(fName);
+        const int fileId = it == m_fileMap.cend() ? 1 : it.value();
+
+        m_query->prepare("INSERT INTO IndexTable (Name, Identifier, NamespaceId, FileId, Anchor) "
+                         "VALUES(?, ?, ?, ?, ?)"_L1);
+        m_query->bindValue(0, itm.name);
+        m_query->bindValue(1, itm.identifier);
+        m_query->bindValue(2, m_namespaceId);
+        m_query->bindValue(3, fileId);
+        m_query->bindValue(4, anchor);
+        m_query->exec();
+
+        indexFilterTable.append(indexId++);
+    }
+    m_query->exec("COMMIT"_L1);
+
+    m_query->exec("BEGIN"_L1);
+    for (int idx : std::as_const(indexFilterTable)) {
+        for (int a : std::as_const(filterAtts)) {
+            m_query->prepare("INSERT INTO IndexFilterTable (FilterAttributeId, IndexId) "
+                             "VALUES(?, ?)"_L1);
+            m_query->bindValue(0, a);
+            m_query->bindValue(1, idx);
+            m_query->exec();
+        }
+    }
+    m_query->exec("COMMIT"_L1);
+
+    m_query->exec("SELECT COUNT(Id) FROM IndexTable"_L1);
+    return m_query->next() && m_query->value(0).toInt() >= indices.size();
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,75 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef QCHTABLEWRITER_H
+#define QCHTABLEWRITER_H
+
+#include <QtCore/QCoreApplication>
+#include <QtCore/QList>
+#include <QtCore/QMap>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QVariant>
+
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+class QSqlQuery;
+
+// Fills the tables of a Qt compressed help (.qch) file. Shared by
+// qhelpgenerator and by QDoc, which can write .qch files directly, so
+// that both write the same rows for the same help project.
+class QchTableWriter
+{
+    Q_DECLARE_TR_FUNCTIONS(QchTableWriter)
+
+public:
+    struct ContentsEntry
+    {
+        int depth;
+        QString reference;
+        QString title;
+    };
+
+    struct Keyword
+    {
+        QString name;
+        QString identifier;
+        QString reference;
+    };
+
+    using WarningHandler = std::function<void(const QString &)>;
+
+    QchTableWriter(QSqlQuery *query, WarningHandler warningHandler);
+
+    bool createTables();
+    bool insertFileNotFoundFile();
+    bool insertMetaData(const QMap<QString, QVariant> &metaData);
+    bool registerVirtualFolder(const QString &folderName, const QString &ns);
+    bool registerCustomFilter(const QString &filterName, const QStringList &filterAttribs);
+    bool insertFilterAttributes(const QStringList &attributes);
+    bool insertFiles(const QStringList &files, const QString &rootPath,
+                     const QStringList &filterAttributes);
+    bool insertContents(const QList<ContentsEntry> &contents,
+                        const QStringList &filterAttributes);
+    bool insertKeywords(const QList<Keyword> &keywords, const QStringList &filterAttributes);
+
+    QString error() const { return m_error; }
+
+private:
+    QSqlQuery *m_query;
+    WarningHandler m_warningHandler;
+    QString m_error;
+
+    int m_namespaceId = -1;
+    int m_virtualFolderId = -1;
+
+    QMap<QString, int> m_fileMap;
+    QMap<int, QSet<int> > m_fileFilterMap;
+};
+
+QT_END_NAMESPACE
+
+#endif // QCHTABLEWRITER_H
@@ -25,6 +25,7 @@
 #include <QtGui/QAction>
 
 #include <QtCore/QDebug>
+#include <QtCore/QFileInfo>
 #include <QtCore/QTime>
 
 QT_BEGIN_NAMESPACE
@@ -460,6 +461,8 @@ static void highlightTargets(const QList<TranslatableEntry> &targets, bool on)
         highlightTarget(target, on);
 }
 
+static const int MaxCachedForms = 8;
+
 FormPreviewView::FormPreviewView(QWidget *parent, MultiDataModel *dataModel)
   : QMainWindow(parent), m_form(0), m_dataModel(dataModel)
 {
@@ -467,11 +470,63 @@ FormPreviewView::FormPreviewView(QWidget *parent, MultiDataModel *dataModel)
     m_mdiSubWindow->setWindowFlags(m_mdiSubWindow->windowFlags() & ~Qt::WindowSystemMenuHint);
     m_mdiArea = new QMdiArea(this);
     m_mdiArea->addSubWindow(m_mdiSubWindow);
+    m_cachedFormsParent = new QWidget(m_mdiArea);
+    m_cachedFormsParent->hide();
     setCentralWidget(m_mdiArea);
     m_mdiArea->setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
     m_mdiArea->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
 }
 
+/*
+ * Moves the current form out of the MDI area into the cache of recently
+ * shown forms, dropping the least recently used one if the cache is full.
+ */
+void FormPreviewView::cacheCurrentForm()
+{
+    if (!m_form)
+        return;
+
+    highlightTargets(m_highlights, false);
+    m_highlights.clear();
+    m_mdiSubWindow->setWidget(nullptr);
+    m_form->hide();
+    m_form->setParent(m_cachedFormsParent);
+    m_cachedForms.prepend({ m_lastFormName, m_lastModified, m_form, m_targets });
+    m_form = 0;
+    m_targets.clear();
+    m_lastFormName.clear();
+
+    while (m_cachedForms.size() > MaxCachedForms) {
+        CachedForm cached = m_cachedForms.takeLast();
+        destroyTargets(&cached.targets);
+        delete cached.form;
+    }
+}
+
+/*
+ * Makes the cached form for \a fileName the current form, unless the file
+ * has been modified since the form was loaded, in which case the cached
+ * form is discarded. Returns whether the form was found.
+ */
+bool FormPreviewView::takeCachedForm(const QString &fileName, const QDateTime &lastModified)
+{
+    for (int i = 0; i < m_cachedForms.size(); ++i) {
+        if (m_cachedForms.at(i).fileName != fileName)
+            continue;
+        CachedForm cached = m_cachedForms.takeAt(i);
+        if (cached.lastModified != lastModified) {
+            destroyTargets(&cached.targets);
+            delete cached.form;
+            return false;
+        }
+        m_form = cached.form;
+        m_targets = cached.targets;
+        m_lastModified = cached.lastModified;
+        return true;
+    }
+    return false;
+}
+
 void FormPreviewView::setSourceContext(int model, MessageItem *messageItem)
 {
     if (model < 0 || !messageItem) {
@@ -482,40 +537,44 @@ void FormPreviewView::setSourceContext(int model, MessageItem *messageItem)
     QDir dir = QFileInfo(m_dataModel->srcFileName(model)).dir();
     QString fileName = QDir::cleanPath(dir.absoluteFilePath(messageItem->fileName()));
     if (m_lastFormName != fileName) {
-        delete m_form;
-        m_form = 0;
-        m_lastFormName.clear();
-        m_highlights.clear();
-        destroyTargets(&m_targets);
-
-        static QUiLoader *uiLoader;
-        if (!uiLoader) {
-            uiLoader = new QUiLoader(this);
-            uiLoader->setLanguageChangeEnabled(true);
-            uiLoader->setTranslationEnabled(false);
-        }
+        cacheCurrentForm();
+
+        const QDateTime lastModified = QFileInfo(fileName).lastModified();
+        if (takeCachedForm(fileName, lastModified)) {
+            m_form->setParent(m_mdiSubWindow);
+            m_form->show();
+        } else {
+            static QUiLoader *uiLoader;
+            if (!uiLoader) {
+                uiLoader = new QUiLoader(this);
+                uiLoader->setLanguageChangeEnabled(true);
+                uiLoader->setTranslationEnabled(false);
+            }
 
-        QFile file(fileName);
-        if (!file.open(QIODevice::ReadOnly)) {
-            qDebug() << "CANNOT OPEN FORM" << fileName;
-            m_mdiSubWindow->hide();
-            return;
-        }
-        m_form = uiLoader->load(&file, m_mdiSubWindow);
-        if (!m_form) {
-            qDebug() << "CANNOT LOAD FORM" << fileName;
-            m_mdiSubWindow->hide();
-            return;
+            QFile file(fileName);
+            if (!file.open(QIODevice::ReadOnly)) {
+                qDebug() << "CANNOT OPEN FORM" << fileName;
+                m_mdiSubWindow->hide();
+                return;
+            }
+            m_form = uiLoader->load(&file, m_mdiSubWindow);
+            if (!m_form) {
+                qDebug() << "CANNOT LOAD FORM" << fileName;
+                m_mdiSubWindow->hide();
+                return;
+            }
+            file.close();
+            buildTargets(m_form, &m_targets);
+            m_lastModified = lastModified;
+
+            m_form->setWindowFlags(Qt::Widget);
+            m_form->setWindowModality(Qt::NonModal);
+            m_form->setFocusPolicy(Qt::NoFocus);
+            m_form->show(); // needed, otherwide the Qt::NoFocus is not propagated.
         }
-        file.close();
-        buildTargets(m_form, &m_targets);
 
         setToolTip(fileName);
 
-        m_form->setWindowFlags(Qt::Widget);
-        m_form->setWindowModality(Qt::NonModal);
-        m_form->setFocusPolicy(Qt::NoFocus);
-        m_form->show(); // needed, otherwide the Qt::NoFocus is not propagated.
         m_mdiSubWindow->setWidget(m_form);
         m_mdiSubWindow->setWindowTitle(m_form->windowTitle());
         m_mdiSubWindow->show();
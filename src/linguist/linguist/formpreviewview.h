@@ -6,6 +6,7 @@
 
 #include <private/quiloader_p.h>
 
+#include <QtCore/QDateTime>
 #include <QtCore/QHash>
 #include <QtCore/QList>
 
@@ -71,11 +72,26 @@ public:
     void setSourceContext(int model, MessageItem *messageItem);
 
 private:
+    struct CachedForm {
+        QString fileName;
+        QDateTime lastModified;
+        QWidget *form;
+        TargetsHash targets;
+    };
+
+    void cacheCurrentForm();
+    bool takeCachedForm(const QString &fileName, const QDateTime &lastModified);
+
     QString m_currentFileName;
     QMdiArea *m_mdiArea;
     QMdiSubWindow *m_mdiSubWindow;
     QWidget *m_form;
     TargetsHash m_targets;
+    QDateTime m_lastModified;
+    // Recently shown forms, most recently used first, kept hidden
+    // for when the user comes back to them
+    QWidget *m_cachedFormsParent;
+    QList<CachedForm> m_cachedForms;
     QList<TranslatableEntry> m_highlights;
     MultiDataModel *m_dataModel;
 
@@ -201,6 +201,21 @@ public:
         return QVariant();
     }
 
+protected:
+    // Compares messages by their precomputed collation keys rather than
+    // collating their source texts anew for every comparison.
+    bool lessThan(const QModelIndex &left, const QModelIndex &right) const override
+    {
+        if (left.column() == m_dataModel->modelCount() && left.parent().isValid()
+            && isSortLocaleAware() && sortRole() == MessageModel::SortRole) {
+            const auto *model = static_cast<const MessageModel *>(sourceModel());
+            const MultiMessageItem *l = m_dataModel->multiMessageItem(model->dataIndex(left, -1));
+            const MultiMessageItem *r = m_dataModel->multiMessageItem(model->dataIndex(right, -1));
+            return l->sortKey().compare(r->sortKey()) < 0;
+        }
+        return QSortFilterProxyModel::lessThan(left, right);
+    }
+
 private:
     MultiDataModel *m_dataModel;
 };
@@ -437,6 +452,24 @@ MainWindow::MainWindow()
             this, &MainWindow::updateProgress);
     connect(m_dataModel, &MultiDataModel::messageDataChanged,
             this, &MainWindow::maybeUpdateStatistics);
+    connect(m_dataModel, &MultiDataModel::messageDataChanged,
+            this, &MainWindow::updateUnfinishedIndex);
+    connect(m_dataModel, &MultiDataModel::modelAppended,
+            this, &MainWindow::invalidateUnfinishedIndex);
+    connect(m_dataModel, &MultiDataModel::modelDeleted,
+            this, &MainWindow::invalidateUnfinishedIndex);
+    connect(m_dataModel, &MultiDataModel::allModelsDeleted,
+            this, &MainWindow::invalidateUnfinishedIndex);
+    for (QSortFilterProxyModel *model : { m_sortedContextsModel, m_sortedMessagesModel }) {
+        connect(model, &QAbstractItemModel::layoutChanged,
+                this, &MainWindow::invalidateUnfinishedIndex);
+        connect(model, &QAbstractItemModel::modelReset,
+                this, &MainWindow::invalidateUnfinishedIndex);
+        connect(model, &QAbstractItemModel::rowsInserted,
+                this, &MainWindow::invalidateUnfinishedIndex);
+        connect(model, &QAbstractItemModel::rowsRemoved,
+                this, &MainWindow::invalidateUnfinishedIndex);
+    }
     connect(m_dataModel, &MultiDataModel::translationChanged,
             this, &MainWindow::translationChanged);
     connect(m_dataModel, &MultiDataModel::languageChanged,
@@ -1545,8 +1578,8 @@ void MainWindow::translationChanged(const MultiDataIndex &index)
         m_formPreviewView->setSourceContext(index.model(), m);
 }
 
-// This and the following function operate directly on the messageitem,
-// so the model does not emit modification notifications.
+// This and the following function change the messageitem without
+// the model emitting modification notifications.
 void MainWindow::updateTranslation(const QStringList &translations)
 {
     MessageItem *m = m_dataModel->messageItem(m_currentIndex);
@@ -1555,7 +1588,7 @@ void MainWindow::updateTranslation(const QStringList &translations)
     if (translations == m->translations())
         return;
 
-    m->setTranslations(translations);
+    m_dataModel->setTranslations(m_currentIndex, translations);
     if (!m->fileName().isEmpty() && hasFormPreview(m->fileName()))
         m_formPreviewView->setSourceContext(m_currentIndex.model(), m);
     updateDanger(m_currentIndex, true);
@@ -1657,6 +1690,9 @@ QModelIndex MainWindow::prevContext(const QModelIndex &index) const
 
 QModelIndex MainWindow::nextMessage(const QModelIndex &currentIndex, bool checkUnfinished) const
 {
+    if (checkUnfinished)
+        return nextUnfinishedMessage(currentIndex);
+
     QModelIndex idx = currentIndex.isValid() ? currentIndex : m_sortedMessagesModel->index(0, 0);
     do {
         int row = 0;
@@ -1686,6 +1722,9 @@ QModelIndex MainWindow::nextMessage(const QModelIndex &currentIndex, bool checkU
 
 QModelIndex MainWindow::prevMessage(const QModelIndex &currentIndex, bool checkUnfinished) const
 {
+    if (checkUnfinished)
+        return prevUnfinishedMessage(currentIndex);
+
     QModelIndex idx = currentIndex.isValid() ? currentIndex : m_sortedMessagesModel->index(0, 0);
     do {
         int row = idx.row() - 1;
@@ -1712,6 +1751,92 @@ QModelIndex MainWindow::prevMessage(const QModelIndex &currentIndex, bool checkU
     return QModelIndex();
 }
 
+/*
+ * Returns the position of \a index, an index in the sorted messages model,
+ * as the pair of the row of its context in the sorted contexts model and
+ * its own row. For a context index, the message row is -1.
+ */
+std::pair<int, int> MainWindow::sortedPosition(const QModelIndex &index) const
+{
+    QModelIndex context = index.parent();
+    int row = index.row();
+    if (!context.isValid()) {
+        context = index;
+        row = -1;
+    }
+    const QModelIndex sortedContext =
+            m_sortedContextsModel->mapFromSource(m_sortedMessagesModel->mapToSource(context));
+    return { sortedContext.row(), row };
+}
+
+QModelIndex MainWindow::sortedMessageIndex(const std::pair<int, int> &position, int column) const
+{
+    const QModelIndex context = m_sortedMessagesModel->mapFromSource(
+            m_sortedContextsModel->mapToSource(m_sortedContextsModel->index(position.first, 0)));
+    return m_sortedMessagesModel->index(position.second, column, context);
+}
+
+void MainWindow::ensureUnfinishedIndex() const
+{
+    if (m_unfinishedIndexValid)
+        return;
+    m_unfinishedIndex.clear();
+    for (int c = 0; c < m_dataModel->contextCount(); ++c) {
+        const MultiContextItem *mc = m_dataModel->multiContextItem(c);
+        for (int m = 0; m < mc->messageCount(); ++m) {
+            if (!mc->multiMessageItem(m)->isUnfinished())
+                continue;
+            const QModelIndex item = m_messageModel->modelIndex(MultiDataIndex(-1, c, m));
+            m_unfinishedIndex.insert(sortedPosition(m_sortedMessagesModel->mapFromSource(item)));
+        }
+    }
+    m_unfinishedIndexValid = true;
+}
+
+void MainWindow::updateUnfinishedIndex(const MultiDataIndex &index)
+{
+    if (!m_unfinishedIndexValid)
+        return;
+    const QModelIndex item = m_messageModel->modelIndex(MultiDataIndex(-1, index.context(),
+                                                                       index.message()));
+    const std::pair<int, int> position =
+            sortedPosition(m_sortedMessagesModel->mapFromSource(item));
+    if (m_dataModel->multiMessageItem(index)->isUnfinished())
+        m_unfinishedIndex.insert(position);
+    else
+        m_unfinishedIndex.erase(position);
+}
+
+/*
+ * Like nextMessage() with checkUnfinished, but looks up the next unfinished
+ * message in m_unfinishedIndex rather than stepping through the views.
+ */
+QModelIndex MainWindow::nextUnfinishedMessage(const QModelIndex &currentIndex) const
+{
+    ensureUnfinishedIndex();
+    if (m_unfinishedIndex.empty())
+        return QModelIndex();
+
+    const QModelIndex idx = currentIndex.isValid() ? currentIndex : m_sortedMessagesModel->index(0, 0);
+    auto it = m_unfinishedIndex.upper_bound(sortedPosition(idx));
+    if (it == m_unfinishedIndex.end())
+        it = m_unfinishedIndex.begin();
+    return sortedMessageIndex(*it, idx.column());
+}
+
+QModelIndex MainWindow::prevUnfinishedMessage(const QModelIndex &currentIndex) const
+{
+    ensureUnfinishedIndex();
+    if (m_unfinishedIndex.empty())
+        return QModelIndex();
+
+    const QModelIndex idx = currentIndex.isValid() ? currentIndex : m_sortedMessagesModel->index(0, 0);
+    auto it = m_unfinishedIndex.lower_bound(sortedPosition(idx));
+    if (it == m_unfinishedIndex.begin())
+        it = m_unfinishedIndex.end();
+    return sortedMessageIndex(*--it, idx.column());
+}
+
 void MainWindow::nextUnfinished()
 {
     if (m_ui.actionNextUnfinished->isEnabled()) {
@@ -2779,7 +2904,6 @@ void MainWindow::maybeUpdateStatistics(const MultiDataIndex &index)
 void MainWindow::updateStatistics()
 {
     // don't call this if stats dialog is not open
-    // because this can be slow...
     if (!m_statistics || !m_statistics->isVisible() || m_currentIndex.model() < 0)
         return;
 
@@ -18,6 +18,9 @@
 
 #include <QtWidgets/QMainWindow>
 
+#include <set>
+#include <utility>
+
 QT_BEGIN_NAMESPACE
 
 class QPixmap;
@@ -148,6 +151,13 @@ private:
     QModelIndex prevContext(const QModelIndex &index) const;
     QModelIndex nextMessage(const QModelIndex &currentIndex, bool checkUnfinished = false) const;
     QModelIndex prevMessage(const QModelIndex &currentIndex, bool checkUnfinished = false) const;
+    QModelIndex nextUnfinishedMessage(const QModelIndex &currentIndex) const;
+    QModelIndex prevUnfinishedMessage(const QModelIndex &currentIndex) const;
+    std::pair<int, int> sortedPosition(const QModelIndex &index) const;
+    QModelIndex sortedMessageIndex(const std::pair<int, int> &position, int column) const;
+    void ensureUnfinishedIndex() const;
+    void invalidateUnfinishedIndex() { m_unfinishedIndexValid = false; }
+    void updateUnfinishedIndex(const MultiDataIndex &index);
     bool doNext(bool checkUnfinished);
     bool doPrev(bool checkUnfinished);
     void findAgain(FindDirection direction = FindNext);
@@ -230,6 +240,11 @@ private:
     int m_editActiveModel;
     MultiDataIndex m_currentIndex;
 
+    // Positions (context row, message row) of the unfinished messages in the
+    // sorted views, in view order. Rebuilt on demand after the views change.
+    mutable std::set<std::pair<int, int>> m_unfinishedIndex;
+    mutable bool m_unfinishedIndexValid = false;
+
     QDockWidget *m_contextDock;
     QDockWidget *m_messagesDock;
     QDockWidget *m_phrasesDock;
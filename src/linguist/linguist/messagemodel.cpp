@@ -90,9 +90,7 @@ DataModel::DataModel(QObject *parent)
   : QObject(parent),
     m_modified(false),
     m_numMessages(0),
-    m_srcWords(0),
-    m_srcChars(0),
-    m_srcCharsSpc(0),
+    m_stats{},
     m_language(QLocale::Language(-1)),
     m_sourceLanguage(QLocale::Language(-1)),
     m_territory(QLocale::Territory(-1)),
@@ -212,9 +210,7 @@ bool DataModel::load(const QString &fileName, bool *langGuessed, QWidget *parent
 
     QHash<QString, int> contexts;
 
-    m_srcWords = 0;
-    m_srcChars = 0;
-    m_srcCharsSpc = 0;
+    m_stats = {};
 
     for (const TranslatorMessage &msg : tor.messages()) {
         if (!contexts.contains(msg.context())) {
@@ -230,10 +226,13 @@ bool DataModel::load(const QString &fileName, bool *langGuessed, QWidget *parent
             if (msg.type() == TranslatorMessage::Finished)
                 c->incrementFinishedCount();
             if (msg.type() == TranslatorMessage::Finished || msg.type() == TranslatorMessage::Unfinished) {
-                doCharCounting(tmp.text(), m_srcWords, m_srcChars, m_srcCharsSpc);
-                doCharCounting(tmp.pluralText(), m_srcWords, m_srcChars, m_srcCharsSpc);
+                doCharCounting(tmp.text(), m_stats.wordsSource, m_stats.charsSource,
+                               m_stats.charsSpacesSource);
+                doCharCounting(tmp.pluralText(), m_stats.wordsSource, m_stats.charsSource,
+                               m_stats.charsSpacesSource);
                 c->incrementNonobsoleteCount();
             }
+            addToStatistics(tmp);
             c->appendMessage(tmp);
             ++m_numMessages;
         }
@@ -414,37 +413,45 @@ void DataModel::setSourceLanguageAndTerritory(QLocale::Language lang, QLocale::T
 
 void DataModel::updateStatistics()
 {
-    StatisticalData stats {};
-    for (DataModelIterator it(this); it.isValid(); ++it) {
-        const MessageItem *mi = it.current();
-        if (mi->isObsolete()) {
-            stats.obsoleteMsg++;
-        } else if (mi->isFinished()) {
-            bool hasDanger = false;
-            for (const QString &trnsl : mi->translations()) {
-                doCharCounting(trnsl, stats.wordsFinished, stats.charsFinished, stats.charsSpacesFinished);
-                hasDanger |= mi->danger();
-            }
-            if (hasDanger)
-                stats.translatedMsgDanger++;
-            else
-                stats.translatedMsgNoDanger++;
-        } else if (mi->isUnfinished()) {
-            bool hasDanger = false;
-            for (const QString &trnsl : mi->translations()) {
-                doCharCounting(trnsl, stats.wordsUnfinished, stats.charsUnfinished, stats.charsSpacesUnfinished);
-                hasDanger |= mi->danger();
-            }
-            if (hasDanger)
-                stats.unfinishedMsgDanger++;
-            else
-                stats.unfinishedMsgNoDanger++;
-        }
+    emit statsChanged(m_stats);
+}
+
+// Adds the contribution of \a mi to the statistics if \a sign is 1,
+// and subtracts it if \a sign is -1.
+void DataModel::countStatistics(const MessageItem &mi, int sign)
+{
+    if (mi.isObsolete()) {
+        m_stats.obsoleteMsg += sign;
+        return;
+    }
+    if (!mi.isFinished() && !mi.isUnfinished())
+        return;
+
+    int words = 0;
+    int chars = 0;
+    int charsSpaces = 0;
+    const QStringList translations = mi.translations();
+    for (const QString &trnsl : translations)
+        doCharCounting(trnsl, words, chars, charsSpaces);
+    const bool hasDanger = mi.danger() && !translations.isEmpty();
+
+    if (mi.isFinished()) {
+        m_stats.wordsFinished += sign * words;
+        m_stats.charsFinished += sign * chars;
+        m_stats.charsSpacesFinished += sign * charsSpaces;
+        if (hasDanger)
+            m_stats.translatedMsgDanger += sign;
+        else
+            m_stats.translatedMsgNoDanger += sign;
+    } else {
+        m_stats.wordsUnfinished += sign * words;
+        m_stats.charsUnfinished += sign * chars;
+        m_stats.charsSpacesUnfinished += sign * charsSpaces;
+        if (hasDanger)
+            m_stats.unfinishedMsgDanger += sign;
+        else
+            m_stats.unfinishedMsgNoDanger += sign;
     }
-    stats.wordsSource = m_srcWords;
-    stats.charsSource = m_srcChars;
-    stats.charsSpacesSource = m_srcCharsSpc;
-    emit statsChanged(stats);
 }
 
 void DataModel::setModified(bool isModified)
@@ -512,6 +519,7 @@ MultiMessageItem::MultiMessageItem(const MessageItem *m)
       m_text(m->text()),
       m_pluralText(m->pluralText()),
       m_comment(m->comment()),
+      m_sortText(m_text.simplified().remove(QLatin1Char('&'))),
       m_nonnullCount(0),
       m_nonobsoleteCount(0),
       m_editableCount(0),
@@ -519,6 +527,15 @@ MultiMessageItem::MultiMessageItem(const MessageItem *m)
 {
 }
 
+// The collation key of sortText(), for comparing it the way
+// QString::localeAwareCompare() does.
+const QCollatorSortKey &MultiMessageItem::sortKey() const
+{
+    if (!m_sortKey)
+        m_sortKey.emplace(QCollator::defaultSortKey(m_sortText));
+    return *m_sortKey;
+}
+
 /******************************************************************************
  *
  * MultiContextItem
@@ -528,6 +545,7 @@ MultiMessageItem::MultiMessageItem(const MessageItem *m)
 MultiContextItem::MultiContextItem(int oldCount, ContextItem *ctx, bool writable)
     : m_context(ctx->context()),
       m_comment(ctx->comment()),
+      m_sortText(m_context.simplified()),
       m_finishedCount(0),
       m_editableCount(0),
       m_nonobsoleteCount(0)
@@ -992,11 +1010,24 @@ void MultiDataModel::setTranslation(const MultiDataIndex &index, const QString &
     MessageItem *m = messageItem(index);
     if (translation == m->translation())
         return;
+    DataModel *dm = m_dataModels[index.model()];
+    dm->removeFromStatistics(*m);
     m->setTranslation(translation);
+    dm->addToStatistics(*m);
     setModified(index.model(), true);
     emit translationChanged(index);
 }
 
+// Does not emit any change notifications.
+void MultiDataModel::setTranslations(const MultiDataIndex &index, const QStringList &translations)
+{
+    MessageItem *m = messageItem(index);
+    DataModel *dm = m_dataModels[index.model()];
+    dm->removeFromStatistics(*m);
+    m->setTranslations(translations);
+    dm->addToStatistics(*m);
+}
+
 void MultiDataModel::setFinished(const MultiDataIndex &index, bool finished)
 {
     MultiContextItem *mc = multiContextItem(index.context());
@@ -1004,8 +1035,11 @@ void MultiDataModel::setFinished(const MultiDataIndex &index, bool finished)
     ContextItem *c = contextItem(index);
     MessageItem *m = messageItem(index);
     TranslatorMessage::Type type = m->type();
+    DataModel *dm = m_dataModels[index.model()];
     if (type == TranslatorMessage::Unfinished && finished) {
+        dm->removeFromStatistics(*m);
         m->setType(TranslatorMessage::Finished);
+        dm->addToStatistics(*m);
         mm->decrementUnfinishedCount();
         if (!mm->countUnfinished()) {
             incrementFinishedCount();
@@ -1025,7 +1059,9 @@ void MultiDataModel::setFinished(const MultiDataIndex &index, bool finished)
         emit messageDataChanged(index);
         setModified(index.model(), true);
     } else if (type == TranslatorMessage::Finished && !finished) {
+        dm->removeFromStatistics(*m);
         m->setType(TranslatorMessage::Unfinished);
+        dm->addToStatistics(*m);
         mm->incrementUnfinishedCount();
         if (mm->countUnfinished() == 1) {
             decrementFinishedCount();
@@ -1062,7 +1098,10 @@ void MultiDataModel::setDanger(const MultiDataIndex &index, bool danger)
                 emit contextDataChanged(index);
         }
         emit messageDataChanged(index);
+        DataModel *dm = m_dataModels[index.model()];
+        dm->removeFromStatistics(*m);
         m->setDanger(danger);
+        dm->addToStatistics(*m);
     } else if (m->danger() && !danger) {
         if (m->isFinished()) {
             c->decrementFinishedDangerCount();
@@ -1074,7 +1113,10 @@ void MultiDataModel::setDanger(const MultiDataIndex &index, bool danger)
                 emit contextDataChanged(index);
         }
         emit messageDataChanged(index);
+        DataModel *dm = m_dataModels[index.model()];
+        dm->removeFromStatistics(*m);
         m->setDanger(danger);
+        dm->addToStatistics(*m);
     }
 }
 
@@ -1325,7 +1367,7 @@ QVariant MessageModel::data(const QModelIndex &index, int role) const
         else if (role == SortRole) {
             switch (column - numLangs) {
             case 0: // Source text
-                return mci->multiMessageItem(row)->text().simplified().remove(QLatin1Char('&'));
+                return mci->multiMessageItem(row)->sortText();
             case 1: // Dummy column
                 return QVariant();
             default:
@@ -1394,7 +1436,7 @@ QVariant MessageModel::data(const QModelIndex &index, int role) const
         else if (role == SortRole) {
             switch (column - numLangs) {
             case 0: // Context (same as display role)
-                return mci->context().simplified();
+                return mci->sortText();
             case 1: // Items
                 return mci->getNumEditable();
             default: // Percent
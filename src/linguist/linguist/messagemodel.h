@@ -7,17 +7,37 @@
 #include "translator.h"
 
 #include <QtCore/QAbstractItemModel>
+#include <QtCore/QCollator>
 #include <QtCore/QList>
 #include <QtCore/QHash>
 #include <QtCore/QLocale>
 #include <QtGui/QColor>
 #include <QtGui/QBitmap>
 
+#include <optional>
+
 QT_BEGIN_NAMESPACE
 
 class DataModel;
 class MultiDataModel;
-struct StatisticalData;
+
+struct StatisticalData
+{
+    int wordsSource;
+    int charsSource;
+    int charsSpacesSource;
+    int wordsFinished;
+    int charsFinished;
+    int charsSpacesFinished;
+    int wordsUnfinished;
+    int charsUnfinished;
+    int charsSpacesUnfinished;
+    int translatedMsgNoDanger;
+    int translatedMsgDanger;
+    int obsoleteMsg;
+    int unfinishedMsgNoDanger;
+    int unfinishedMsgDanger;
+};
 
 class MessageItem
 {
@@ -189,9 +209,9 @@ public:
     void doCharCounting(const QString& text, int& trW, int& trC, int& trCS);
     void updateStatistics();
 
-    int getSrcWords() const { return m_srcWords; }
-    int getSrcChars() const { return m_srcChars; }
-    int getSrcCharsSpc() const { return m_srcCharsSpc; }
+    int getSrcWords() const { return m_stats.wordsSource; }
+    int getSrcChars() const { return m_stats.charsSource; }
+    int getSrcCharsSpc() const { return m_stats.charsSpacesSource; }
 
 signals:
     void statsChanged(const StatisticalData &newStats);
@@ -201,20 +221,23 @@ signals:
 
 private:
     friend class DataModelIterator;
+    friend class MultiDataModel;
     QList<ContextItem> m_contextList;
 
     bool save(const QString &fileName, QWidget *parent);
     void updateLocale();
+    // To be called around each change to the type, translations or danger of a message
+    void addToStatistics(const MessageItem &m) { countStatistics(m, 1); }
+    void removeFromStatistics(const MessageItem &m) { countStatistics(m, -1); }
+    void countStatistics(const MessageItem &m, int sign);
 
     bool m_writable;
     bool m_modified;
 
     int m_numMessages;
 
-    // For statistics
-    int m_srcWords;
-    int m_srcChars;
-    int m_srcCharsSpc;
+    // Kept up to date as messages change
+    StatisticalData m_stats;
 
     QString m_srcFileName;
     QLocale::Language m_language;
@@ -238,6 +261,9 @@ public:
     QString text() const { return m_text; }
     QString pluralText() const { return m_pluralText; }
     QString comment() const { return m_comment; }
+    // For sorting by source text; the source text does not change
+    const QString &sortText() const { return m_sortText; }
+    const QCollatorSortKey &sortKey() const;
     bool isEmpty() const { return !m_nonnullCount; }
     // The next two include also read-only
     bool isObsolete() const { return m_nonnullCount && !m_nonobsoleteCount; }
@@ -262,6 +288,8 @@ private:
     QString m_text;
     QString m_pluralText;
     QString m_comment;
+    QString m_sortText;
+    mutable std::optional<QCollatorSortKey> m_sortKey;
     int m_nonnullCount; // all
     int m_nonobsoleteCount; // all
     int m_editableCount; // read-write
@@ -284,6 +312,7 @@ public:
 
     QString context() const { return m_context; }
     QString comment() const { return m_comment; }
+    const QString &sortText() const { return m_sortText; }
     int messageCount() const { return m_messageLists.isEmpty() ? 0 : m_messageLists[0].size(); }
     // For item count in context list
     int getNumFinished() const { return m_finishedCount; }
@@ -309,6 +338,7 @@ private:
 
     QString m_context;
     QString m_comment;
+    QString m_sortText;
     QList<MultiMessageItem> m_multiMessageList;
     QList<ContextItem *> m_contextList;
     // The next two could be in the MultiMessageItems, but are here for efficiency
@@ -397,6 +427,7 @@ public:
 
     // Per message
     void setTranslation(const MultiDataIndex &index, const QString &translation);
+    void setTranslations(const MultiDataIndex &index, const QStringList &translations);
     void setFinished(const MultiDataIndex &index, bool finished);
     void setDanger(const MultiDataIndex &index, bool danger);
 
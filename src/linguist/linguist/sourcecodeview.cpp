@@ -10,15 +10,29 @@
 #include <QtGui/QTextCharFormat>
 #include <QtGui/QTextBlock>
 #include <QtGui/QTextCursor>
+#include <QtGui/QTextDocument>
 
 QT_BEGIN_NAMESPACE
 
+// Total size, in characters, of the files whose documents are kept around
+static const qsizetype MaxCachedDocumentsSize = 16 * 1024 * 1024;
+
+static QTextDocument *createPlainTextDocument(QObject *parent, const QFont &font)
+{
+    QTextDocument *document = new QTextDocument(parent);
+    document->setDocumentLayout(new QPlainTextDocumentLayout(document));
+    document->setDefaultFont(font);
+    return document;
+}
+
 SourceCodeView::SourceCodeView(QWidget *parent)
   : QPlainTextEdit(parent),
     m_isActive(true),
     m_lineNumToLoad(0)
 {
     setReadOnly(true);
+    m_messageDocument = createPlainTextDocument(this, font());
+    setDocument(m_messageDocument);
 }
 
 void SourceCodeView::setSourceContext(const QString &fileName, const int lineNum)
@@ -27,9 +41,7 @@ void SourceCodeView::setSourceContext(const QString &fileName, const int lineNum
     setToolTip(fileName);
 
     if (fileName.isEmpty()) {
-        clear();
-        m_currentFileName.clear();
-        appendHtml(tr("<i>Source code not available</i>"));
+        showMessage(tr("<i>Source code not available</i>"));
         return;
     }
 
@@ -50,34 +62,80 @@ void SourceCodeView::setActivated(bool activated)
     }
 }
 
-void SourceCodeView::showSourceCode(const QString &absFileName, const int lineNum)
+void SourceCodeView::showMessage(const QString &html)
 {
-    QString fileText = fileHash.value(absFileName);
+    // Never clear a cached document; messages have a document of their own
+    setDocument(m_messageDocument);
+    clear();
+    m_currentFileName.clear();
+    appendHtml(html);
+}
 
-    if (fileText.isNull()) { // File not in hash
-        m_currentFileName.clear();
+/*
+    Returns the document holding the contents of \a absFileName. The
+    document built when the file was last shown is reused, unless the
+    file has been modified since. If the file cannot be read, a message
+    is shown instead and \nullptr is returned.
+*/
+QTextDocument *SourceCodeView::sourceDocument(const QString &absFileName)
+{
+    const QDateTime lastModified = QFileInfo(absFileName).lastModified();
+    for (qsizetype i = 0; i < m_documents.size(); ++i) {
+        if (m_documents.at(i).fileName != absFileName)
+            continue;
+        const CachedDocument cached = m_documents.takeAt(i);
+        if (cached.lastModified == lastModified) {
+            m_documents.prepend(cached);
+            return cached.document;
+        }
+        if (document() == cached.document)
+            setDocument(m_messageDocument);
+        m_documentsSize -= cached.size;
+        delete cached.document;
+        break;
+    }
 
-        // Assume fileName is relative to directory
-        QFile file(absFileName);
+    // Assume fileName is relative to directory
+    QFile file(absFileName);
 
-        if (!file.exists()) {
-            clear();
-            appendHtml(tr("<i>File %1 not available</i>").arg(absFileName));
-            return;
-        }
-        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
-            clear();
-            appendHtml(tr("<i>File %1 not readable</i>").arg(absFileName));
-            return;
-        }
-        fileText = QString::fromUtf8(file.readAll());
-        fileHash.insert(absFileName, fileText);
+    if (!file.exists()) {
+        showMessage(tr("<i>File %1 not available</i>").arg(absFileName));
+        return nullptr;
     }
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        showMessage(tr("<i>File %1 not readable</i>").arg(absFileName));
+        return nullptr;
+    }
+    const QString fileText = QString::fromUtf8(file.readAll());
+
+    QTextDocument *sourceDoc = createPlainTextDocument(this, font());
+    sourceDoc->setPlainText(fileText);
+    m_documents.prepend({ absFileName, lastModified, sourceDoc, fileText.size() });
+    m_documentsSize += fileText.size();
+    return sourceDoc;
+}
+
+// Drops the least recently shown documents, but never the current one,
+// until the cached files are within MaxCachedDocumentsSize in total.
+void SourceCodeView::trimDocumentCache()
+{
+    while (m_documents.size() > 1 && m_documentsSize > MaxCachedDocumentsSize) {
+        const CachedDocument cached = m_documents.takeLast();
+        m_documentsSize -= cached.size;
+        delete cached.document;
+    }
+}
 
+void SourceCodeView::showSourceCode(const QString &absFileName, const int lineNum)
+{
+    QTextDocument *sourceDoc = sourceDocument(absFileName);
+    if (!sourceDoc)
+        return;
 
-    if (m_currentFileName != absFileName) {
-        setPlainText(fileText);
+    if (document() != sourceDoc) {
+        setDocument(sourceDoc);
         m_currentFileName = absFileName;
+        trimDocumentCache();
     }
 
     QTextCursor cursor = textCursor();
@@ -4,12 +4,15 @@
 #ifndef SOURCECODEVIEW_H
 #define SOURCECODEVIEW_H
 
+#include <QDateTime>
 #include <QDir>
-#include <QHash>
+#include <QList>
 #include <QPlainTextEdit>
 
 QT_BEGIN_NAMESPACE
 
+class QTextDocument;
+
 class SourceCodeView : public QPlainTextEdit
 {
     Q_OBJECT
@@ -21,14 +24,27 @@ public slots:
     void setActivated(bool activated);
 
 private:
+    struct CachedDocument {
+        QString fileName;
+        QDateTime lastModified;
+        QTextDocument *document;
+        qsizetype size;
+    };
+
     void showSourceCode(const QString &fileName, const int lineNum);
+    void showMessage(const QString &html);
+    QTextDocument *sourceDocument(const QString &absFileName);
+    void trimDocumentCache();
 
     bool m_isActive;
     QString m_fileToLoad;
     int m_lineNumToLoad;
     QString m_currentFileName;
 
-    QHash<QString, QString> fileHash;
+    QTextDocument *m_messageDocument;
+    // Documents of recently shown files, most recently used first
+    QList<CachedDocument> m_documents;
+    qsizetype m_documentsSize = 0;
 };
 
 QT_END_NAMESPACE
@@ -0,0 +1,119 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "cachingfilesystem.h"
+
+#include <llvm/ADT/SmallString.h>
+
+QT_BEGIN_NAMESPACE
+
+namespace {
+
+class CachedFile : public llvm::vfs::File
+{
+public:
+    CachedFile(llvm::vfs::Status status, const llvm::MemoryBuffer *buffer)
+        : m_status(std::move(status))
+        , m_buffer(buffer)
+    {}
+
+    llvm::ErrorOr<llvm::vfs::Status> status() override { return m_status; }
+
+    llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>>
+    getBuffer(const llvm::Twine &name, int64_t, bool requiresNullTerminator, bool) override
+    {
+        // The cached buffer is always null terminated, so it can be
+        // handed out without copying either way.
+        return llvm::MemoryBuffer::getMemBuffer(m_buffer->getBuffer(), name.str(),
+                                                requiresNullTerminator);
+    }
+
+    std::error_code close() override { return {}; }
+
+private:
+    llvm::vfs::Status m_status;
+    const llvm::MemoryBuffer *m_buffer;
+};
+
+} // namespace
+
+llvm::ErrorOr<llvm::vfs::Status> SharedFileCache::status(const std::string &path,
+                                                         llvm::vfs::FileSystem &fileSystem)
+{
+    {
+        QMutexLocker lock(&m_mutex);
+        const auto it = m_status.find(path);
+        if (it != m_status.end())
+            return it->second;
+    }
+
+    // Stat outside of the lock; if another thread got there first, both
+    // results are the same.
+    llvm::ErrorOr<llvm::vfs::Status> result = fileSystem.status(path);
+    QMutexLocker lock(&m_mutex);
+    return m_status.try_emplace(path, std::move(result)).first->second;
+}
+
+llvm::ErrorOr<const llvm::MemoryBuffer *>
+SharedFileCache::buffer(const llvm::vfs::Status &status, const std::string &path,
+                        llvm::vfs::FileSystem &fileSystem)
+{
+    {
+        QMutexLocker lock(&m_mutex);
+        const auto it = m_buffers.find(status.getUniqueID());
+        if (it != m_buffers.end())
+            return it->second.get();
+    }
+
+    auto buffer = fileSystem.getBufferForFile(path, status.getSize(), true, false);
+    if (!buffer)
+        return buffer.getError();
+
+    QMutexLocker lock(&m_mutex);
+    return m_buffers.try_emplace(status.getUniqueID(), std::move(*buffer)).first->second.get();
+}
+
+bool CachingFileSystem::absolutePath(const llvm::Twine &path, std::string *result) const
+{
+    llvm::SmallString<256> absolute;
+    path.toVector(absolute);
+    if (makeAbsolute(absolute))
+        return false;
+    *result = std::string(absolute.str());
+    return true;
+}
+
+llvm::ErrorOr<llvm::vfs::Status> CachingFileSystem::status(const llvm::Twine &path)
+{
+    std::string absolute;
+    if (!absolutePath(path, &absolute))
+        return ProxyFileSystem::status(path);
+
+    llvm::ErrorOr<llvm::vfs::Status> result = m_cache->status(absolute, getUnderlyingFS());
+    if (!result)
+        return result.getError();
+    return llvm::vfs::Status::copyWithNewName(*result, path);
+}
+
+llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>>
+CachingFileSystem::openFileForRead(const llvm::Twine &path)
+{
+    std::string absolute;
+    if (!absolutePath(path, &absolute))
+        return ProxyFileSystem::openFileForRead(path);
+
+    llvm::ErrorOr<llvm::vfs::Status> status = m_cache->status(absolute, getUnderlyingFS());
+    if (!status)
+        return status.getError();
+    if (!status->isRegularFile())
+        return ProxyFileSystem::openFileForRead(path);
+
+    llvm::ErrorOr<const llvm::MemoryBuffer *> buffer =
+            m_cache->buffer(*status, absolute, getUnderlyingFS());
+    if (!buffer)
+        return buffer.getError();
+    return std::unique_ptr<llvm::vfs::File>(
+            new CachedFile(llvm::vfs::Status::copyWithNewName(*status, path), *buffer));
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,80 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef CACHINGFILESYSTEM_H
+#define CACHINGFILESYSTEM_H
+
+#include <QtCore/qmutex.h>
+
+QT_WARNING_PUSH
+QT_WARNING_DISABLE_MSVC(4100)
+QT_WARNING_DISABLE_MSVC(4146)
+QT_WARNING_DISABLE_MSVC(4267)
+QT_WARNING_DISABLE_MSVC(4624)
+
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/VirtualFileSystem.h>
+
+QT_WARNING_POP
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Status results and file contents that are shared by all the
+    CachingFileSystem instances of an lupdate run. The sources and
+    headers do not change while lupdate runs, so each file is stat'ed
+    and read at most once, however many translation units include it.
+
+    Contents are keyed by the unique ID of the file, so that a file
+    that is reached through several paths is read only once.
+*/
+class SharedFileCache
+{
+    Q_DISABLE_COPY_MOVE(SharedFileCache)
+
+public:
+    SharedFileCache() = default;
+
+    llvm::ErrorOr<llvm::vfs::Status> status(const std::string &path,
+                                            llvm::vfs::FileSystem &fileSystem);
+    llvm::ErrorOr<const llvm::MemoryBuffer *> buffer(const llvm::vfs::Status &status,
+                                                     const std::string &path,
+                                                     llvm::vfs::FileSystem &fileSystem);
+
+private:
+    QMutex m_mutex;
+    std::unordered_map<std::string, llvm::ErrorOr<llvm::vfs::Status>> m_status;
+    std::map<llvm::sys::fs::UniqueID, std::unique_ptr<llvm::MemoryBuffer>> m_buffers;
+};
+
+/*
+    A file system that passes everything through to the real file
+    system, except that stat calls and reads of regular files are
+    served from a SharedFileCache.
+*/
+class CachingFileSystem : public llvm::vfs::ProxyFileSystem
+{
+public:
+    CachingFileSystem(SharedFileCache *cache)
+        : llvm::vfs::ProxyFileSystem(llvm::vfs::getRealFileSystem())
+        , m_cache(cache)
+    {}
+
+    llvm::ErrorOr<llvm::vfs::Status> status(const llvm::Twine &path) override;
+    llvm::ErrorOr<std::unique_ptr<llvm::vfs::File>>
+    openFileForRead(const llvm::Twine &path) override;
+
+private:
+    bool absolutePath(const llvm::Twine &path, std::string *result) const;
+
+    SharedFileCache *m_cache = nullptr;
+};
+
+QT_END_NAMESPACE
+
+#endif
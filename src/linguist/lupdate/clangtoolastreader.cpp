@@ -718,10 +718,16 @@ void LupdateVisitor::setInfoFromRawComment(const QString &commentString,
 
 void LupdateVisitor::processPreprocessorCalls()
 {
-    QString inputFile = toQt(m_inputFile);
-    for (const auto &store : m_stores->Preprocessor) {
-        if (store.lupdateInputFile == inputFile)
+    if (m_ppStores) {
+        // Collected while parsing, so they all come from the current input file.
+        for (const auto &store : *m_ppStores)
             processPreprocessorCall(store);
+    } else {
+        QString inputFile = toQt(m_inputFile);
+        for (const auto &store : m_stores->Preprocessor) {
+            if (store.lupdateInputFile == inputFile)
+                processPreprocessorCall(store);
+        }
     }
 
     // Processing the isolated comments (TRANSLATOR) in the files included in the main input file.
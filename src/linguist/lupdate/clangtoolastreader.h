@@ -5,6 +5,7 @@
 #define CLANG_TOOL_AST_READER_H
 
 #include "cpp_clang.h"
+#include "lupdatepreprocessoraction.h"
 
 QT_WARNING_PUSH
 QT_WARNING_DISABLE_MSVC(4100)
@@ -31,14 +32,17 @@ class LupdateVisitor : public clang::RecursiveASTVisitor<LupdateVisitor>
 {
 public:
 #if (LUPDATE_CLANG_VERSION >= LUPDATE_CLANG_VERSION_CHECK(14,0,0))
-    explicit LupdateVisitor(clang::ASTContext *context,
-                            clang::Preprocessor *preprocessor, Stores *stores)
+    explicit LupdateVisitor(clang::ASTContext *context, clang::Preprocessor *preprocessor,
+                            const TranslationStores *ppStores, Stores *stores)
         : m_context(context)
         , m_preprocessor(preprocessor)
+        , m_ppStores(ppStores)
         , m_stores(stores)
 #else
-    explicit LupdateVisitor(clang::ASTContext *context, Stores *stores)
+    explicit LupdateVisitor(clang::ASTContext *context, const TranslationStores *ppStores,
+                            Stores *stores)
         : m_context(context)
+        , m_ppStores(ppStores)
         , m_stores(stores)
 #endif
     {
@@ -68,6 +72,7 @@ private:
 #endif
     std::string m_inputFile;
 
+    const TranslationStores *m_ppStores = nullptr;
     Stores *m_stores = nullptr;
 
     TranslationStores m_trCalls;
@@ -81,18 +86,28 @@ class LupdateASTConsumer : public clang::ASTConsumer
 public:
 #if (LUPDATE_CLANG_VERSION >= LUPDATE_CLANG_VERSION_CHECK(14,0,0))
     explicit LupdateASTConsumer(clang::ASTContext *context, clang::Preprocessor *preprocessor,
-                                Stores *stores)
-        : m_visitor(context, preprocessor, stores)
+                                const TranslationStores *ppStores, Stores *stores,
+                                bool *fatalErrorOccurred)
+        : m_visitor(context, preprocessor, ppStores, stores)
 #else
-    explicit LupdateASTConsumer(clang::ASTContext *context, Stores *stores)
-        : m_visitor(context, stores)
+    explicit LupdateASTConsumer(clang::ASTContext *context, const TranslationStores *ppStores,
+                                Stores *stores, bool *fatalErrorOccurred)
+        : m_visitor(context, ppStores, stores)
 #endif
+        , m_fatalErrorOccurred(fatalErrorOccurred)
     {}
 
     // This method is called when the ASTs for entire translation unit have been
     // parsed.
     void HandleTranslationUnit(clang::ASTContext &context) override
     {
+        // After a fatal error, such as a missing include, the preprocessor calls
+        // collected while parsing are incomplete. The translation unit is then
+        // left to a separate preprocessor pass, see ClangCppParser::loadCPP().
+        if (m_fatalErrorOccurred && context.getDiagnostics().hasFatalErrorOccurred()) {
+            *m_fatalErrorOccurred = true;
+            return;
+        }
         m_visitor.processPreprocessorCalls();
         bool traverse = m_visitor.TraverseAST(context);
         qCDebug(lcClang) << "TraverseAST: " << traverse;
@@ -101,52 +116,71 @@ public:
 
 private:
     LupdateVisitor m_visitor;
+    bool *m_fatalErrorOccurred = nullptr;
 };
 
+// Usually parses a translation unit once: the preprocessor callbacks collect the
+// translation related macro calls while the file is being parsed, and the
+// visitor processes them together with the AST once parsing is done. If
+// fatalErrorOccurred is null, the macro calls have been collected into
+// Stores::Preprocessor by a LupdatePreprocessorAction instead.
 class LupdateFrontendAction : public clang::ASTFrontendAction
 {
 public:
-    LupdateFrontendAction(Stores *stores)
+    LupdateFrontendAction(Stores *stores, bool *fatalErrorOccurred)
         : m_stores(stores)
+        , m_fatalErrorOccurred(fatalErrorOccurred)
     {}
 
     std::unique_ptr<clang::ASTConsumer> CreateASTConsumer(
         clang::CompilerInstance &compiler, llvm::StringRef /* inFile */) override
     {
+        auto &preprocessor = compiler.getPreprocessor();
+        const TranslationStores *ppStores = nullptr;
+        if (m_fatalErrorOccurred) {
+            auto callbacks = new LupdatePPCallbacks(preprocessor);
+            preprocessor.addPPCallbacks(std::unique_ptr<clang::PPCallbacks>(callbacks));
+            ppStores = &callbacks->stores();
+        }
+
         #if (LUPDATE_CLANG_VERSION >= LUPDATE_CLANG_VERSION_CHECK(14,0,0))
-            auto consumer = new LupdateASTConsumer(&compiler.getASTContext(),
-                                                   &compiler.getPreprocessor(), m_stores);
+            auto consumer = new LupdateASTConsumer(&compiler.getASTContext(), &preprocessor,
+                                                   ppStores, m_stores, m_fatalErrorOccurred);
         #else
-            auto consumer = new LupdateASTConsumer(&compiler.getASTContext(), m_stores);
+            auto consumer = new LupdateASTConsumer(&compiler.getASTContext(), ppStores,
+                                                   m_stores, m_fatalErrorOccurred);
         #endif
         return std::unique_ptr<clang::ASTConsumer>(consumer);
     }
 
 private:
     Stores *m_stores = nullptr;
+    bool *m_fatalErrorOccurred = nullptr;
 };
 
 class LupdateToolActionFactory : public clang::tooling::FrontendActionFactory
 {
 public:
-    LupdateToolActionFactory(Stores *stores)
+    LupdateToolActionFactory(Stores *stores, bool *fatalErrorOccurred = nullptr)
         : m_stores(stores)
+        , m_fatalErrorOccurred(fatalErrorOccurred)
     {}
 
 #if (LUPDATE_CLANG_VERSION >= LUPDATE_CLANG_VERSION_CHECK(10,0,0))
     std::unique_ptr<clang::FrontendAction> create() override
     {
-        return std::make_unique<LupdateFrontendAction>(m_stores);
+        return std::make_unique<LupdateFrontendAction>(m_stores, m_fatalErrorOccurred);
     }
 #else
     clang::FrontendAction *create() override
     {
-        return new LupdateFrontendAction(m_stores);
+        return new LupdateFrontendAction(m_stores, m_fatalErrorOccurred);
     }
 #endif
 
 private:
     Stores *m_stores = nullptr;
+    bool *m_fatalErrorOccurred = nullptr;
 };
 
 QT_END_NAMESPACE
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
 #include "cpp.h"
+#include "excludematcher.h"
 
 #include <translator.h>
 #include <QtCore/QBitArray>
@@ -73,6 +74,7 @@ public:
     void setInput(const QString &in);
     void setInput(QTextStream &ts, const QString &fileName);
     void setTranslator(Translator *_tor) { tor = _tor; }
+    void setExcludeMatcher(const ExcludeMatcher *matcher) { excludeMatcher = matcher; }
     void parse(ConversionData &cd, const QStringList &includeStack, QSet<QString> &inclusions);
     void parseInternal(ConversionData &cd, const QStringList &includeStack, QSet<QString> &inclusions);
     const ParseResults *recordResults(bool isHeader);
@@ -165,6 +167,7 @@ private:
     void enterNamespace(NamespaceList *namespaces, const HashString &name);
     void truncateNamespaces(NamespaceList *namespaces, int lenght);
     Namespace *modifyNamespace(NamespaceList *namespaces, bool haveLast = true);
+    void invalidateQualifyCache() { results->qualifyCache.clear(); }
 
     // Tokenizer state
     QString yyFileName;
@@ -202,6 +205,7 @@ private:
     QString prospectiveContext;
     ParseResults *results;
     Translator *tor;
+    const ExcludeMatcher *excludeMatcher;
     bool directInclude;
 
     CppParserState savedState;
@@ -212,6 +216,7 @@ private:
 CppParser::CppParser(ParseResults *_results)
 {
     tor = 0;
+    excludeMatcher = 0;
     if (_results) {
         results = _results;
         directInclude = true;
@@ -941,6 +946,7 @@ Namespace *CppParser::modifyNamespace(NamespaceList *namespaces, bool haveLast)
                 pns->children.insert(namespaces->at(i), ns);
                 pns = ns;
             } while (++i < namespaces->size());
+            invalidateQualifyCache();
             break;
         }
     }
@@ -1056,12 +1062,34 @@ bool CppParser::qualifyOne(const NamespaceList &namespaces, int nsCnt, const Has
     return visitNamespace(namespaces, nsCnt, &CppParser::qualifyOneCallbackUsing, &data);
 }
 
+/*
+  The same segments are looked up in the same scopes over and over, once
+  for every tr() call and class reference, and each lookup walks the scope
+  chain, the using directives and the namespaces of all included files.
+  The results are therefore remembered until the namespaces of the file
+  being parsed or its includes change.
+*/
 bool CppParser::qualifyOne(const NamespaceList &namespaces, int nsCnt, const HashString &segment,
                            NamespaceList *resolved) const
 {
-    QSet<HashStringList> visitedUsings;
+    NamespaceList key = namespaces.mid(0, nsCnt);
+    key << segment;
+    HashStringList cacheKey(key);
+    auto it = results->qualifyCache.constFind(cacheKey);
+    if (it != results->qualifyCache.constEnd()) {
+        if (it->isEmpty())
+            return false;
+        *resolved = *it;
+        return true;
+    }
 
-    return qualifyOne(namespaces, nsCnt, segment, resolved, &visitedUsings);
+    QSet<HashStringList> visitedUsings;
+    NamespaceList result;
+    const bool found = qualifyOne(namespaces, nsCnt, segment, &result, &visitedUsings);
+    results->qualifyCache.insert(cacheKey, result);
+    if (found)
+        *resolved = result;
+    return found;
 }
 
 bool CppParser::fullyQualify(const NamespaceList &namespaces, int nsCnt,
@@ -1273,10 +1301,8 @@ void CppParser::processInclude(const QString &file, ConversionData &cd, const QS
 {
     QString cleanFile = QDir::cleanPath(file);
 
-    for (const QRegularExpression &rx : std::as_const(cd.m_excludes)) {
-        if (rx.match(cleanFile).hasMatch())
-            return;
-    }
+    if (excludeMatcher && excludeMatcher->isExcluded(cleanFile))
+        return;
 
     const int index = includeStack.indexOf(cleanFile);
     if (index != -1) {
@@ -1296,6 +1322,7 @@ void CppParser::processInclude(const QString &file, ConversionData &cd, const QS
         QSet<const ParseResults *> res = CppFiles::getResults(ResultsCacheKey(cleanFile, *this));
         if (!res.isEmpty()) {
             results->includes.unite(res);
+            invalidateQualifyCache();
             return;
         }
 
@@ -1321,11 +1348,13 @@ void CppParser::processInclude(const QString &file, ConversionData &cd, const QS
                 parser.setTranslator(new Translator);
                 break;
             }
+        parser.setExcludeMatcher(excludeMatcher);
         parser.setInput(ts, cleanFile);
         QStringList stack = includeStack;
         stack << cleanFile;
         parser.parse(cd, stack, inclusions);
         results->includes.insert(parser.recordResults(true));
+        invalidateQualifyCache();
     } else {
         CppParser parser(results);
         parser.namespaces = namespaces;
@@ -1333,6 +1362,7 @@ void CppParser::processInclude(const QString &file, ConversionData &cd, const QS
         parser.functionContextUnresolved = functionContextUnresolved;
         parser.setInput(ts, cleanFile);
         parser.setTranslator(tor);
+        parser.setExcludeMatcher(excludeMatcher);
         QStringList stack = includeStack;
         stack << cleanFile;
         parser.parseInternal(cd, stack, inclusions);
@@ -1856,6 +1886,7 @@ void CppParser::parseInternal(ConversionData &cd, const QStringList &includeStac
                         break;
                     fullName.append(HashString(QString())); // Mark as unresolved
                     modifyNamespace(&namespaces)->aliases[ns] = fullName;
+                    invalidateQualifyCache();
                 }
             } else if (yyTok == Tok_LeftBrace) {
                 // Anonymous namespace
@@ -1881,8 +1912,10 @@ void CppParser::parseInternal(ConversionData &cd, const QStringList &includeStac
                     yyTok = getToken();
                 }
                 NamespaceList nsl;
-                if (fullyQualify(namespaces, fullName, false, &nsl, 0))
+                if (fullyQualify(namespaces, fullName, false, &nsl, 0)) {
                     modifyNamespace(&namespaces)->usings << HashStringList(nsl);
+                    invalidateQualifyCache();
+                }
             } else {
                 NamespaceList fullName;
                 if (yyTok == Tok_ColonColon)
@@ -1904,6 +1937,7 @@ void CppParser::parseInternal(ConversionData &cd, const QStringList &includeStac
                 fullName.append(HashString(QString())); // Mark as unresolved
                 const HashString &ns = *(fullName.constEnd() - 2);
                 modifyNamespace(&namespaces)->aliases[ns] = fullName;
+                invalidateQualifyCache();
             }
             break;
         case Tok_Q_OBJECT:
@@ -2252,6 +2286,8 @@ const ParseResults *CppParser::recordResults(bool isHeader)
             delete results;
         } else {
             results->fileId = nextFileId++;
+            results->qualifyCache.clear();
+            results->qualifyCache.squeeze();
             pr = results;
         }
         CppFiles::setResults(ResultsCacheKey(yyFileName, *this), pr);
@@ -2265,6 +2301,7 @@ const ParseResults *CppParser::recordResults(bool isHeader)
 void loadCPP(Translator &translator, const QStringList &filenames, ConversionData &cd)
 {
     QStringConverter::Encoding e = cd.m_sourceIsUtf16 ? QStringConverter::Utf16 : QStringConverter::Utf8;
+    const ExcludeMatcher excludeMatcher(cd.m_excludes);
 
     for (const QString &filename : filenames) {
         if (!CppFiles::getResults(ResultsCacheKey(filename)).isEmpty() || CppFiles::isBlacklisted(filename))
@@ -2282,6 +2319,7 @@ void loadCPP(Translator &translator, const QStringList &filenames, ConversionDat
         ts.setEncoding(e);
         ts.setAutoDetectUnicode(true);
         parser.setInput(ts, filename);
+        parser.setExcludeMatcher(&excludeMatcher);
         Translator *tor = new Translator;
         parser.setTranslator(tor);
         QSet<QString> inclusions;
@@ -77,6 +77,11 @@ struct ParseResults {
     int fileId;
     Namespace rootNamespace;
     QSet<const ParseResults *> includes;
+
+    // Results of CppParser::qualifyOne(), keyed on the scope followed by the
+    // segment. An empty value means that the segment could not be resolved.
+    // Valid as long as rootNamespace and includes are unchanged.
+    QHash<HashStringList, NamespaceList> qualifyCache;
 };
 
 struct IncludeCycle {
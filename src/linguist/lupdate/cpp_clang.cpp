@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
 #include "cpp_clang.h"
+#include "cachingfilesystem.h"
 #include "clangtoolastreader.h"
 #include "filesignificancecheck.h"
 #include "lupdatepreprocessoraction.h"
@@ -29,6 +30,7 @@
 
 #include <cstdio>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <array>
@@ -457,40 +459,49 @@ void ClangCppParser::loadCPP(Translator &translator, const QStringList &files, C
     TranslationStores ast, qdecl, qnoop;
     Stores stores(ast, qdecl, qnoop);
 
+    // Usually each file is parsed once: LupdateFrontendAction collects the
+    // preprocessor calls and visits the AST of the same translation unit.
     std::vector<std::thread> producers;
-    ReadSynchronizedRef<std::string> ppSources(sources);
-    WriteSynchronizedRef<TranslationRelatedStore> ppStore(stores.Preprocessor);
-    size_t idealProducerCount = std::min(ppSources.size(), size_t(std::thread::hardware_concurrency()));
+    ReadSynchronizedRef<std::string> astSources(sources);
+    size_t idealProducerCount = std::min(astSources.size(),
+                                         size_t(std::thread::hardware_concurrency()));
     clang::tooling::ArgumentsAdjuster argumentsAdjusterSyntaxOnly =
             clang::tooling::getClangSyntaxOnlyAdjuster();
     clang::tooling::ArgumentsAdjuster argumentsAdjusterLocal = getClangArgumentAdjuster();
     clang::tooling::ArgumentsAdjuster argumentsAdjuster =
             clang::tooling::combineAdjusters(argumentsAdjusterLocal, argumentsAdjusterSyntaxOnly);
 
-    for (size_t i = 0; i < idealProducerCount; ++i) {
-        std::thread producer([&ppSources, &db, &ppStore, &argumentsAdjuster]() {
-            std::string file;
-            while (ppSources.next(&file)) {
-                clang::tooling::ClangTool tool(*db, file);
-                tool.appendArgumentsAdjuster(argumentsAdjuster);
-                tool.run(new LupdatePreprocessorActionFactory(&ppStore));
-            }
-        });
-        producers.emplace_back(std::move(producer));
-    }
-    for (auto &producer : producers)
-        producer.join();
-    producers.clear();
+    // The headers are shared by most of the sources, so the workers read them
+    // through a common cache rather than each hitting the file system again.
+    // Setting LUPDATE_NO_FILE_CACHE disables the cache.
+    std::optional<SharedFileCache> fileCache;
+    if (!std::getenv("LUPDATE_NO_FILE_CACHE"))
+        fileCache.emplace();
+
+    auto makeTool = [&db, &argumentsAdjuster, &fileCache](const std::string &file) {
+        llvm::IntrusiveRefCntPtr<llvm::vfs::FileSystem> fileSystem =
+                llvm::vfs::getRealFileSystem();
+        if (fileCache)
+            fileSystem = llvm::makeIntrusiveRefCnt<CachingFileSystem>(&*fileCache);
+        auto tool = std::make_unique<clang::tooling::ClangTool>(
+                *db, file, std::make_shared<clang::PCHContainerOperations>(), fileSystem);
+        tool->appendArgumentsAdjuster(argumentsAdjuster);
+        return tool;
+    };
+
+    // Translation units whose parse stopped at a fatal error, such as a missing include
+    std::vector<std::string> failedSources;
+    WriteSynchronizedRef<std::string> failedSourcesRef(failedSources);
 
-    ReadSynchronizedRef<std::string> astSources(sources);
-    idealProducerCount = std::min(astSources.size(), size_t(std::thread::hardware_concurrency()));
     for (size_t i = 0; i < idealProducerCount; ++i) {
-        std::thread producer([&astSources, &db, &stores, &argumentsAdjuster]() {
+        std::thread producer([&astSources, &stores, &makeTool, &failedSourcesRef]() {
             std::string file;
             while (astSources.next(&file)) {
-                clang::tooling::ClangTool tool(*db, file);
-                tool.appendArgumentsAdjuster(argumentsAdjuster);
-                tool.run(new LupdateToolActionFactory(&stores));
+                bool fatalErrorOccurred = false;
+                LupdateToolActionFactory factory(&stores, &fatalErrorOccurred);
+                makeTool(file)->run(&factory);
+                if (fatalErrorOccurred)
+                    failedSourcesRef.emplace_back(std::move(file));
             }
         });
         producers.emplace_back(std::move(producer));
@@ -499,6 +510,49 @@ void ClangCppParser::loadCPP(Translator &translator, const QStringList &files, C
         producer.join();
     producers.clear();
 
+    // The preprocessor carries on after a missing include, but the parser does
+    // not. For those translation units, collect the preprocessor calls in a
+    // separate pass, and then parse them again reading the calls from
+    // stores.Preprocessor.
+    if (!failedSources.empty()) {
+        ReadSynchronizedRef<std::string> ppSources(failedSources);
+        WriteSynchronizedRef<TranslationRelatedStore> ppStore(stores.Preprocessor);
+        idealProducerCount = std::min(ppSources.size(),
+                                      size_t(std::thread::hardware_concurrency()));
+        for (size_t i = 0; i < idealProducerCount; ++i) {
+            std::thread producer([&ppSources, &ppStore, &makeTool]() {
+                std::string file;
+                while (ppSources.next(&file)) {
+                    LupdatePreprocessorActionFactory factory(&ppStore);
+                    makeTool(file)->run(&factory);
+                }
+            });
+            producers.emplace_back(std::move(producer));
+        }
+        for (auto &producer : producers)
+            producer.join();
+        producers.clear();
+
+        ReadSynchronizedRef<std::string> failedAstSources(failedSources);
+        for (size_t i = 0; i < idealProducerCount; ++i) {
+            std::thread producer([&failedAstSources, &stores, &makeTool]() {
+                std::string file;
+                while (failedAstSources.next(&file)) {
+                    // The diagnostics have been reported by the first parse already
+                    clang::IgnoringDiagConsumer diagnostics;
+                    auto tool = makeTool(file);
+                    tool->setDiagnosticConsumer(&diagnostics);
+                    LupdateToolActionFactory factory(&stores);
+                    tool->run(&factory);
+                }
+            });
+            producers.emplace_back(std::move(producer));
+        }
+        for (auto &producer : producers)
+            producer.join();
+        producers.clear();
+    }
+
     TranslationStores finalStores;
     WriteSynchronizedRef<TranslationRelatedStore> wsv(finalStores);
 
@@ -0,0 +1,65 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "excludematcher.h"
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+ExcludeMatcher::ExcludeMatcher(const QVector<QRegularExpression> &expressions)
+{
+    // Invalid expressions never match, so they are left out; they would
+    // make the whole alternation invalid.
+    QVector<QRegularExpression::PatternOptions> options;
+    QVector<QString> patterns;
+    for (const QRegularExpression &rx : expressions) {
+        if (!rx.isValid())
+            continue;
+        const qsizetype index = options.indexOf(rx.patternOptions());
+        if (index == -1) {
+            options.append(rx.patternOptions());
+            patterns.append("(?:"_L1 + rx.pattern() + u')');
+        } else {
+            patterns[index] += "|(?:"_L1 + rx.pattern() + u')';
+        }
+    }
+
+    m_expressions.reserve(patterns.size());
+    for (qsizetype i = 0; i < patterns.size(); ++i) {
+        QRegularExpression combined(patterns.at(i), options.at(i));
+        combined.optimize();
+        m_expressions.append(std::move(combined));
+    }
+}
+
+/*
+    Returns true if \a cleanFilePath, a path as returned by
+    QDir::cleanPath(), matches any of the exclusion patterns.
+*/
+bool ExcludeMatcher::isExcluded(const QString &cleanFilePath) const
+{
+    if (m_expressions.isEmpty())
+        return false;
+
+    {
+        QReadLocker locker(&m_cacheLock);
+        const auto it = m_cache.constFind(cleanFilePath);
+        if (it != m_cache.cend())
+            return it.value();
+    }
+
+    bool excluded = false;
+    for (const QRegularExpression &rx : m_expressions) {
+        if (rx.match(cleanFilePath).hasMatch()) {
+            excluded = true;
+            break;
+        }
+    }
+
+    QWriteLocker locker(&m_cacheLock);
+    m_cache.insert(cleanFilePath, excluded);
+    return excluded;
+}
+
+QT_END_NAMESPACE
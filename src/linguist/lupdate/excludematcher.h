@@ -0,0 +1,44 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef EXCLUDEMATCHER_H
+#define EXCLUDEMATCHER_H
+
+#include <QtCore/qhash.h>
+#include <QtCore/qreadwritelock.h>
+#include <QtCore/qregularexpression.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qvector.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Decides whether a file is excluded from translation by the
+    TR_EXCLUDE patterns of a project.
+
+    The patterns are combined into a single alternation, so that a path
+    is matched once rather than once per pattern, and the verdict for
+    each path is remembered. The builtin C++ parser creates one matcher
+    for each call of loadCPP(), and FileSignificanceCheck one for the
+    clang C++ parser, which may use it from multiple threads.
+*/
+class ExcludeMatcher
+{
+    Q_DISABLE_COPY_MOVE(ExcludeMatcher)
+
+public:
+    explicit ExcludeMatcher(const QVector<QRegularExpression> &expressions);
+
+    bool isEmpty() const { return m_expressions.isEmpty(); }
+    bool isExcluded(const QString &cleanFilePath) const;
+
+private:
+    // One combined expression per set of pattern options
+    QVector<QRegularExpression> m_expressions;
+    mutable QHash<QString, bool> m_cache;
+    mutable QReadWriteLock m_cacheLock;
+};
+
+QT_END_NAMESPACE
+
+#endif // EXCLUDEMATCHER_H
@@ -17,7 +17,7 @@ void FileSignificanceCheck::setRootDirectories(const QStringList &paths)
 
 void FileSignificanceCheck::setExclusionRegExes(const QVector<QRegularExpression> &expressions)
 {
-    m_exclusionRegExes = expressions;
+    m_excludeMatcher = std::make_unique<ExcludeMatcher>(expressions);
 }
 
 /*
@@ -43,11 +43,9 @@ bool FileSignificanceCheck::isFileSignificant(const std::string &filePath) const
     QWriteLocker locker(&m_cacheLock);
     QString file = QString::fromUtf8(filePath);
     QString cleanFile = QDir::cleanPath(file);
-    for (const QRegularExpression &rx : m_exclusionRegExes) {
-        if (rx.match(cleanFile).hasMatch()) {
-            m_cache.insert({filePath, false});
-            return false;
-        }
+    if (m_excludeMatcher && m_excludeMatcher->isExcluded(cleanFile)) {
+        m_cache.insert({filePath, false});
+        return false;
     }
 
     for (const QDir &rootDir : m_rootDirs) {
@@ -4,12 +4,13 @@
 #ifndef FILESIGNIFICANCECHECK_H
 #define FILESIGNIFICANCECHECK_H
 
+#include "excludematcher.h"
+
 #include <QtCore/qdir.h>
 #include <QtCore/qreadwritelock.h>
-#include <QtCore/qregularexpression.h>
 #include <QtCore/qstringlist.h>
-#include <QtCore/qvector.h>
 
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -45,7 +46,7 @@ public:
 private:
     static FileSignificanceCheck *m_instance;
     std::vector<QDir> m_rootDirs;
-    QVector<QRegularExpression> m_exclusionRegExes;
+    std::unique_ptr<const ExcludeMatcher> m_excludeMatcher;
     mutable std::unordered_map<std::string, bool> m_cache;
     mutable QReadWriteLock m_cacheLock;
 };
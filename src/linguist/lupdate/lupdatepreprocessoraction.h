@@ -26,10 +26,15 @@ QT_WARNING_POP
 
 QT_BEGIN_NAMESPACE
 
+// Collects the translation related macro calls while the main file is being
+// preprocessed. If a shared store is given, they are written to it once the
+// file is done; otherwise, LupdateFrontendAction hands them to the
+// LupdateVisitor of the same translation unit.
 class LupdatePPCallbacks : public clang::PPCallbacks
 {
 public:
-    LupdatePPCallbacks(WriteSynchronizedRef<TranslationRelatedStore> *stores, clang::Preprocessor &pp)
+    explicit LupdatePPCallbacks(clang::Preprocessor &pp,
+                                WriteSynchronizedRef<TranslationRelatedStore> *stores = nullptr)
         : m_preprocessor(pp)
         , m_stores(stores)
     {
@@ -39,9 +44,12 @@ public:
 
     ~LupdatePPCallbacks() override
     {
-        m_stores->emplace_bulk(std::move(m_ppStores));
+        if (m_stores)
+            m_stores->emplace_bulk(std::move(m_ppStores));
     }
 
+    const TranslationStores &stores() const { return m_ppStores; }
+
 private:
     void MacroExpands(const clang::Token &token, const clang::MacroDefinition &macroDefinition,
         clang::SourceRange sourceRange, const clang::MacroArgs *macroArgs) override;
@@ -72,6 +80,9 @@ private:
     WriteSynchronizedRef<TranslationRelatedStore> *m_stores { nullptr };
 };
 
+// Only run on the translation units whose parse stopped at a fatal error, such
+// as a missing include, see ClangCppParser::loadCPP(). Unlike the parser, it
+// carries on after a missing include.
 class LupdatePreprocessorAction : public clang::PreprocessOnlyAction
 {
 public:
@@ -84,7 +95,7 @@ private:
     {
         auto &preprocessor = getCompilerInstance().getPreprocessor();
         preprocessor.SetSuppressIncludeNotFoundError(true);
-        auto callbacks = new LupdatePPCallbacks(m_stores, preprocessor);
+        auto callbacks = new LupdatePPCallbacks(preprocessor, m_stores);
         preprocessor.addPPCallbacks(std::unique_ptr<clang::PPCallbacks>(callbacks));
 
         clang::PreprocessOnlyAction::ExecuteAction();
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
 #include "lupdate.h"
+#include "excludematcher.h"
 #if QT_CONFIG(clangcpp)
 #include "cpp_clang.h"
 #endif
@@ -499,13 +500,11 @@ static bool readFileContent(const QString &filePath, QString *content, QString *
 static void removeExcludedSources(Projects &projects)
 {
     for (Project &project : projects) {
-        for (const QRegularExpression &rx : project.excluded) {
-            for (auto it = project.sources.begin(); it != project.sources.end(); ) {
-                if (rx.match(*it).hasMatch())
-                    it = project.sources.erase(it);
-                else
-                    ++it;
-            }
+        const ExcludeMatcher matcher(project.excluded);
+        if (!matcher.isEmpty()) {
+            project.sources.removeIf([&matcher](const QString &source) {
+                return matcher.isExcluded(source);
+            });
         }
         removeExcludedSources(project.subProjects);
     }
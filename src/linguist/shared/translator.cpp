@@ -5,6 +5,7 @@
 
 #include "simtexth.h"
 
+#include <algorithm>
 #include <iostream>
 
 #include <stdio.h>
@@ -26,8 +27,12 @@
 QT_BEGIN_NAMESPACE
 
 Translator::Translator() :
+    m_ordered(true),
+    m_firstIdx(-1),
+    m_lastIdx(-1),
     m_locationsType(AbsoluteLocations),
-    m_indexOk(true)
+    m_indexOk(true),
+    m_fileIndexOk(false)
 {
 }
 
@@ -76,6 +81,7 @@ void Translator::ensureIndexed() const
 {
     if (!m_indexOk) {
         m_indexOk = true;
+        m_fileIndexOk = false;
         m_ctxCmtIdx.clear();
         m_idMsgIdx.clear();
         m_msgIdx.clear();
@@ -84,15 +90,95 @@ void Translator::ensureIndexed() const
     }
 }
 
+// Only valid while the messages are ordered, as the index is then the position.
+void Translator::addFileIndex(int idx, const TranslatorMessage &msg) const
+{
+    Q_ASSERT(m_ordered);
+    QList<int> &indexes = m_fileMsgIdx[TMMFileKey(msg)];
+    const auto it = std::lower_bound(indexes.cbegin(), indexes.cend(), idx);
+    indexes.insert(it - indexes.cbegin(), idx);
+}
+
+void Translator::delFileIndex(int idx) const
+{
+    Q_ASSERT(m_ordered);
+    auto fit = m_fileMsgIdx.find(TMMFileKey(m_messages.at(idx)));
+    if (fit == m_fileMsgIdx.end())
+        return;
+    const auto it = std::lower_bound(fit->cbegin(), fit->cend(), idx);
+    if (it != fit->cend() && *it == idx)
+        fit->remove(it - fit->cbegin());
+    if (fit->isEmpty())
+        m_fileMsgIdx.erase(fit);
+}
+
+void Translator::ensureFileIndexed() const
+{
+    ensureIndexed();
+    if (!m_fileIndexOk) {
+        ensureOrdered();
+        m_fileIndexOk = true;
+        m_fileMsgIdx.clear();
+        for (int i = 0; i < m_messages.size(); i++)
+            m_fileMsgIdx[TMMFileKey(m_messages.at(i))].append(i);
+    }
+}
+
+/*
+    Moves the messages into the order of the linked list that appendSorted()
+    maintains, and updates the indexes accordingly.
+*/
+void Translator::ensureOrdered() const
+{
+    if (m_ordered)
+        return;
+    m_ordered = true;
+
+    QList<int> newIdx(m_messages.size());
+    TMM messages;
+    messages.reserve(m_messages.size());
+    for (int i = m_firstIdx; i >= 0; i = m_nextIdx.at(i)) {
+        newIdx[i] = messages.size();
+        messages.append(std::move(m_messages[i]));
+    }
+    m_messages = std::move(messages);
+    m_nextIdx.clear();
+    m_prevIdx.clear();
+
+    if (m_indexOk) {
+        for (int &idx : m_ctxCmtIdx)
+            idx = newIdx.at(idx);
+        for (int &idx : m_idMsgIdx)
+            idx = newIdx.at(idx);
+        for (int &idx : m_msgIdx)
+            idx = newIdx.at(idx);
+        if (m_fileIndexOk) {
+            for (QList<int> &indexes : m_fileMsgIdx) {
+                for (int &idx : indexes)
+                    idx = newIdx.at(idx);
+            }
+        }
+    }
+}
+
 void Translator::replaceSorted(const TranslatorMessage &msg)
 {
-    int index = find(msg);
+    int index = findIndex(msg);
     if (index == -1) {
         appendSorted(msg);
     } else {
+        const bool refile = m_fileIndexOk
+                && !(TMMFileKey(m_messages.at(index)) == TMMFileKey(msg));
+        if (refile) {
+            ensureOrdered();
+            index = findIndex(msg);
+            delFileIndex(index);
+        }
         delIndex(index);
         m_messages[index] = msg;
         addIndex(index, msg);
+        if (refile)
+            addFileIndex(index, msg);
     }
 }
 
@@ -111,10 +197,16 @@ static QString makeMsgId(const TranslatorMessage &msg)
 
 void Translator::extend(const TranslatorMessage &msg, ConversionData &cd)
 {
-    int index = find(msg);
+    int index = findIndex(msg);
     if (index == -1) {
         append(msg);
     } else {
+        // The first reference determines the file the message is indexed under.
+        const bool refile = m_fileIndexOk && m_messages.at(index).fileName().isEmpty();
+        if (refile) {
+            ensureOrdered();
+            index = findIndex(msg);
+        }
         TranslatorMessage &emsg = m_messages[index];
         if (emsg.sourceText().isEmpty()) {
             delIndex(index);
@@ -134,7 +226,11 @@ void Translator::extend(const TranslatorMessage &msg, ConversionData &cd)
                                 : QString::fromLatin1("message '%1'").arg(makeMsgId(msg))));
             return;
         }
+        if (refile)
+            delFileIndex(index);
         emsg.addReferenceUniq(msg.fileName(), msg.lineNumber());
+        if (refile)
+            addFileIndex(index, emsg);
         if (!msg.extraComment().isEmpty()) {
             QString cmt = emsg.extraComment();
             if (!cmt.isEmpty()) {
@@ -151,22 +247,79 @@ void Translator::extend(const TranslatorMessage &msg, ConversionData &cd)
     }
 }
 
-void Translator::insert(int idx, const TranslatorMessage &msg)
+void Translator::append(const TranslatorMessage &msg)
 {
+    const int idx = m_messages.size();
+    m_messages.append(msg);
+    if (!m_ordered) {
+        m_nextIdx.append(-1);
+        m_prevIdx.append(m_lastIdx);
+        m_nextIdx[m_lastIdx] = idx;
+        m_lastIdx = idx;
+    }
     if (m_indexOk) {
-        if (idx == m_messages.size())
-            addIndex(idx, msg);
-        else
-            m_indexOk = false;
+        addIndex(idx, msg);
+        if (m_fileIndexOk)
+            m_fileMsgIdx[TMMFileKey(msg)].append(idx);
     }
-    m_messages.insert(idx, msg);
 }
 
-void Translator::append(const TranslatorMessage &msg)
+/*
+    Inserts msg after the message at index after, or first if after is -1,
+    and at fileIdxPos among the messages of the same context and file.
+
+    The message is appended to m_messages and linked into the order, so
+    no other message moves. Switching to linked order costs one pass over
+    the messages, as does ensureOrdered() when they are next accessed by
+    position.
+*/
+void Translator::insertAfter(int after, int fileIdxPos, const TranslatorMessage &msg)
 {
-    insert(m_messages.size(), msg);
+    Q_ASSERT(m_indexOk && m_fileIndexOk);
+    if (after == last()) {
+        append(msg);
+        return;
+    }
+
+    if (m_ordered) {
+        m_ordered = false;
+        const int size = m_messages.size();
+        m_nextIdx.resize(size);
+        m_prevIdx.resize(size);
+        for (int i = 0; i < size; ++i) {
+            m_nextIdx[i] = i + 1;
+            m_prevIdx[i] = i - 1;
+        }
+        m_nextIdx[size - 1] = -1;
+        m_firstIdx = 0;
+        m_lastIdx = size - 1;
+    }
+
+    const int idx = m_messages.size();
+    const int next = after < 0 ? m_firstIdx : m_nextIdx.at(after);
+    m_messages.append(msg);
+    m_nextIdx.append(next);
+    m_prevIdx.append(after);
+    if (after < 0)
+        m_firstIdx = idx;
+    else
+        m_nextIdx[after] = idx;
+    m_prevIdx[next] = idx;
+
+    addIndex(idx, msg);
+    m_fileMsgIdx[TMMFileKey(msg)].insert(fileIdxPos, idx);
 }
 
+/*
+    Inserts msg next to the messages from the same context and file with
+    the closest line numbers.
+
+    A region is a run of adjacent messages from the same context and file
+    with ascending line numbers. The message goes into the middle of a region
+    if its line number falls within it, otherwise before or after a region,
+    preferring longer regions. Only the messages of the same context and file
+    need to be looked at, as any other message just ends a region.
+*/
 void Translator::appendSorted(const TranslatorMessage &msg)
 {
     int msgLine = msg.lineNumber();
@@ -175,53 +328,72 @@ void Translator::appendSorted(const TranslatorMessage &msg)
         return;
     }
 
-    int bestIdx = 0; // Best insertion point found so far
+    ensureFileIndexed();
+
+    // Where to insert: after the message at index after, or first if after is -1,
+    // and at fileIdxPos among the messages of the same context and file.
+    struct InsertionPoint {
+        int after = -1;
+        int fileIdxPos = 0;
+    };
+
+    InsertionPoint best; // Best insertion point found so far
     int bestScore = 0; // Its category: 0 = no hit, 1 = pre or post, 2 = middle
     int bestSize = 0; // The length of the region. Longer is better within one category.
 
     // The insertion point to use should this region turn out to be the best one so far
-    int thisIdx = 0;
+    InsertionPoint thisPoint;
     int thisScore = 0;
     int thisSize = 0;
     // Working vars
     int prevLine = 0;
-    int curIdx = 0;
-    for (const TranslatorMessage &mit : std::as_const(m_messages)) {
-        bool sameFile = mit.fileName() == msg.fileName() && mit.context() == msg.context();
-        int curLine;
-        if (sameFile && (curLine = mit.lineNumber()) >= prevLine) {
+    int prevIdx = -1;
+
+    const auto endRegion = [&](InsertionPoint point, bool sameFile) {
+        if (!thisScore) {
+            thisPoint = point;
+            thisScore = 1;
+        }
+        if (thisScore > bestScore || (thisScore == bestScore && thisSize > bestSize)) {
+            best = thisPoint;
+            bestScore = thisScore;
+            bestSize = thisSize;
+        }
+        thisScore = 0;
+        thisSize = sameFile ? 1 : 0;
+        prevLine = 0;
+    };
+
+    const auto fit = m_fileMsgIdx.constFind(TMMFileKey(msg));
+    const int fileCount = fit != m_fileMsgIdx.constEnd() ? fit->size() : 0;
+    for (int i = 0; i < fileCount; ++i) {
+        const int curIdx = fit->at(i);
+        if (thisSize && previous(curIdx) != prevIdx)
+            endRegion({ prevIdx, i }, false);
+        const int curLine = m_messages.at(curIdx).lineNumber();
+        if (curLine >= prevLine) {
             if (msgLine >= prevLine && msgLine < curLine) {
-                thisIdx = curIdx;
+                thisPoint = { previous(curIdx), i };
                 thisScore = thisSize ? 2 : 1;
             }
             ++thisSize;
             prevLine = curLine;
-        } else {
-            if (thisSize) {
-                if (!thisScore) {
-                    thisIdx = curIdx;
-                    thisScore = 1;
-                }
-                if (thisScore > bestScore || (thisScore == bestScore && thisSize > bestSize)) {
-                    bestIdx = thisIdx;
-                    bestScore = thisScore;
-                    bestSize = thisSize;
-                }
-                thisScore = 0;
-                thisSize = sameFile ? 1 : 0;
-                prevLine = 0;
-            }
+        } else if (thisSize) {
+            endRegion({ previous(curIdx), i }, true);
         }
-        ++curIdx;
+        prevIdx = curIdx;
     }
+
+    if (thisSize && prevIdx != last())
+        endRegion({ prevIdx, fileCount }, false);
     if (thisSize && !thisScore) {
-        thisIdx = curIdx;
+        thisPoint = { last(), fileCount };
         thisScore = 1;
     }
     if (thisScore > bestScore || (thisScore == bestScore && thisSize > bestSize))
-        insert(thisIdx, msg);
+        insertAfter(thisPoint.after, thisPoint.fileIdxPos, msg);
     else if (bestScore)
-        insert(bestIdx, msg);
+        insertAfter(best.after, best.fileIdxPos, msg);
     else
         append(msg);
 }
@@ -357,7 +529,7 @@ void Translator::languageAndTerritory(QStringView languageCode, QLocale::Languag
         *territoryPtr = territory;
 }
 
-int Translator::find(const TranslatorMessage &msg) const
+int Translator::findIndex(const TranslatorMessage &msg) const
 {
     ensureIndexed();
     if (msg.id().isEmpty())
@@ -370,9 +542,16 @@ int Translator::find(const TranslatorMessage &msg) const
     return i >= 0 && m_messages.at(i).id().isEmpty() ? i : -1;
 }
 
+int Translator::find(const TranslatorMessage &msg) const
+{
+    ensureOrdered();
+    return findIndex(msg);
+}
+
 int Translator::find(const QString &context,
     const QString &comment, const TranslatorMessage::References &refs) const
 {
+    ensureOrdered();
     if (!refs.isEmpty()) {
         for (auto it = m_messages.cbegin(), end = m_messages.cend(); it != end; ++it) {
             if (it->context() == context && it->comment() == comment) {
@@ -390,12 +569,14 @@ int Translator::find(const QString &context,
 
 int Translator::find(const QString &context) const
 {
+    ensureOrdered();
     ensureIndexed();
     return m_ctxCmtIdx.value(context, -1);
 }
 
 void Translator::stripObsoleteMessages()
 {
+    ensureOrdered();
     for (auto it = m_messages.begin(); it != m_messages.end(); )
         if (it->type() == TranslatorMessage::Obsolete || it->type() == TranslatorMessage::Vanished)
             it = m_messages.erase(it);
@@ -406,6 +587,7 @@ void Translator::stripObsoleteMessages()
 
 void Translator::stripFinishedMessages()
 {
+    ensureOrdered();
     for (auto it = m_messages.begin(); it != m_messages.end(); )
         if (it->type() == TranslatorMessage::Finished)
             it = m_messages.erase(it);
@@ -416,6 +598,7 @@ void Translator::stripFinishedMessages()
 
 void Translator::stripUntranslatedMessages()
 {
+    ensureOrdered();
     for (auto it = m_messages.begin(); it != m_messages.end(); )
         if (!it->isTranslated())
             it = m_messages.erase(it);
@@ -435,6 +618,7 @@ bool Translator::translationsExist() const
 
 void Translator::stripEmptyContexts()
 {
+    ensureOrdered();
     for (auto it = m_messages.begin(); it != m_messages.end(); )
         if (it->sourceText() == QLatin1String(ContextComment))
             it = m_messages.erase(it);
@@ -445,6 +629,7 @@ void Translator::stripEmptyContexts()
 
 void Translator::stripNonPluralForms()
 {
+    ensureOrdered();
     for (auto it = m_messages.begin(); it != m_messages.end(); )
         if (!it->isPlural())
             it = m_messages.erase(it);
@@ -455,6 +640,7 @@ void Translator::stripNonPluralForms()
 
 void Translator::stripIdenticalSourceTranslations()
 {
+    ensureOrdered();
     for (auto it = m_messages.begin(); it != m_messages.end(); ) {
         // we need to have just one translation, and it be equal to the source
         if (it->translations().size() == 1 && it->translation() == it->sourceText())
@@ -492,6 +678,7 @@ void Translator::dropUiLines()
         }
         message.setReferences(refs);
     }
+    m_fileIndexOk = false;
 }
 
 class TranslatorMessagePtrBase
@@ -561,6 +748,7 @@ Translator::Duplicates Translator::resolveDuplicates()
     Duplicates dups;
     QSet<TranslatorMessageIdPtr> idRefs;
     QSet<TranslatorMessageContentPtr> contentRefs;
+    ensureOrdered();
     for (int i = 0; i < m_messages.size();) {
         const TranslatorMessage &msg = m_messages.at(i);
         TranslatorMessage *omsg;
@@ -659,10 +847,12 @@ void Translator::makeFileNamesAbsolute(const QDir &originalPath)
             msg.addReference(fileName, ref.lineNumber());
         }
     }
+    m_fileIndexOk = false;
 }
 
 const QList<TranslatorMessage> &Translator::messages() const
 {
+    ensureOrdered();
     return m_messages;
 }
 
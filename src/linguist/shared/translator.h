@@ -85,6 +85,20 @@ inline size_t qHash(const TMMKey &key)
     return qHash(key.context) ^ qHash(key.source) ^ qHash(key.comment);
 }
 
+class TMMFileKey {
+public:
+    TMMFileKey(const TranslatorMessage &msg)
+        { context = msg.context(); fileName = msg.fileName(); }
+    bool operator==(const TMMFileKey &o) const
+        { return context == o.context && fileName == o.fileName; }
+    QString context, fileName;
+};
+Q_DECLARE_TYPEINFO(TMMFileKey, Q_RELOCATABLE_TYPE);
+inline size_t qHash(const TMMFileKey &key)
+{
+    return qHash(key.context) ^ qHash(key.fileName);
+}
+
 class Translator
 {
 public:
@@ -144,9 +158,9 @@ public:
     QStringList normalizedTranslations(const TranslatorMessage &m, ConversionData &cd, bool *ok) const;
 
     int messageCount() const { return m_messages.size(); }
-    TranslatorMessage &message(int i) { return m_messages[i]; }
-    const TranslatorMessage &message(int i) const { return m_messages.at(i); }
-    const TranslatorMessage &constMessage(int i) const { return m_messages.at(i); }
+    TranslatorMessage &message(int i) { ensureOrdered(); return m_messages[i]; }
+    const TranslatorMessage &message(int i) const { ensureOrdered(); return m_messages.at(i); }
+    const TranslatorMessage &constMessage(int i) const { ensureOrdered(); return m_messages.at(i); }
     void dump() const;
 
     void setDependencies(const QStringList &dependencies) { m_dependencies = dependencies; }
@@ -183,14 +197,30 @@ public:
     static constexpr QChar BinaryVariantSeparator{0x9c}; // unicode "STRING TERMINATOR"
 
 private:
-    void insert(int idx, const TranslatorMessage &msg);
+    void insertAfter(int after, int fileIdxPos, const TranslatorMessage &msg);
+    int findIndex(const TranslatorMessage &msg) const;
     void addIndex(int idx, const TranslatorMessage &msg) const;
     void delIndex(int idx) const;
     void ensureIndexed() const;
+    void addFileIndex(int idx, const TranslatorMessage &msg) const;
+    void delFileIndex(int idx) const;
+    void ensureFileIndexed() const;
+    void ensureOrdered() const;
+    int previous(int idx) const { return m_ordered ? idx - 1 : m_prevIdx.at(idx); }
+    int last() const { return m_ordered ? m_messages.size() - 1 : m_lastIdx; }
 
     typedef QList<TranslatorMessage> TMM;       // int stores the sequence position.
 
-    TMM m_messages;
+    // Messages inserted by appendSorted() are appended to m_messages, and
+    // their order is kept in a list linked through m_nextIdx and m_prevIdx.
+    // The messages are only brought into that order when they are accessed
+    // by position, so that positions need not be renumbered on every insert.
+    mutable TMM m_messages;
+    mutable bool m_ordered;
+    mutable QList<int> m_nextIdx;
+    mutable QList<int> m_prevIdx;
+    int m_firstIdx;
+    int m_lastIdx;
     LocationsType m_locationsType;
 
     // A string beginning with a 2 or 3 letter language code (ISO 639-1
@@ -211,6 +241,10 @@ private:
     mutable QHash<QString, int> m_ctxCmtIdx;
     mutable QHash<QString, int> m_idMsgIdx;
     mutable QHash<TMMKey, int> m_msgIdx;
+    // Indexes of the messages of each context and file, in message order;
+    // used by appendSorted(). Only valid if m_indexOk is, too.
+    mutable bool m_fileIndexOk;
+    mutable QHash<TMMFileKey, QList<int>> m_fileMsgIdx;
 };
 
 bool getNumerusInfo(QLocale::Language language, QLocale::Territory territory, QByteArray *rules,
@@ -4,10 +4,14 @@
 #include "config.h"
 #include "utilities.h"
 
+#include "filesystem/directorywalker.h"
+
 #include <QtCore/qdir.h>
 #include <QtCore/qfile.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qtemporaryfile.h>
 #include <QtCore/qtextstream.h>
+#include <QtCore/qthreadpool.h>
 #include <QtCore/qvariant.h>
 #include <QtCore/qregularexpression.h>
 
@@ -207,6 +211,59 @@ QSet<QString> Config::overrideOutputFormats;
 QMap<QString, QString> Config::m_extractedDirs;
 QStack<QString> Config::m_workingDirs;
 QMap<QString, QStringList> Config::m_includeFilesMap;
+QHash<QString, QString> Config::m_copiedFiles;
+QSet<QString> Config::m_copyTargetDirs;
+
+namespace {
+
+/*
+  The worker that copies files for Config::copyFile(). It has a single
+  thread, so that copies to the same target happen in the order they
+  were requested. Failures are collected to be reported from the main
+  thread, as Location is not thread-safe.
+*/
+struct FileCopier
+{
+    FileCopier() { pool.setMaxThreadCount(1); }
+
+    QThreadPool pool;
+    QMutex mutex;
+    QList<std::pair<Location, QString>> failures;
+};
+
+} // namespace
+
+Q_GLOBAL_STATIC(FileCopier, fileCopier)
+
+/*
+  Copies \a sourceFilePath to \a targetFilePath, unless the target has
+  the size and modification time of the source, which it is given when
+  it is copied. QFile::copy() lets the kernel do the copy where it can.
+*/
+static QString copyIfChanged(const QString &sourceFilePath, const QString &targetFilePath)
+{
+    const QFileInfo source(sourceFilePath);
+    const QFileInfo target(targetFilePath);
+    const QDateTime lastModified = source.lastModified();
+    if (target.exists() && target.size() == source.size()
+        && target.lastModified() == lastModified)
+        return QString();
+
+    if (target.exists() && !QFile::remove(targetFilePath))
+        return QStringLiteral("Cannot replace output file");
+
+    QFile sourceFile(sourceFilePath);
+    if (!sourceFile.copy(targetFilePath))
+        return sourceFile.errorString();
+
+    // The copy has the permissions of the source, which may not allow
+    // it to be replaced by the next run.
+    QFile targetFile(targetFilePath);
+    targetFile.setPermissions(targetFile.permissions() | QFileDevice::WriteOwner);
+    if (targetFile.open(QFile::Append))
+        targetFile.setFileTime(lastModified, QFileDevice::FileModificationTime);
+    return QString();
+}
 
 /*!
   \class ConfigVar
@@ -735,8 +792,8 @@ QString Config::getIncludeFilePath(const QString &fileName) const
             getCanonicalPathList(CONFIG_SOURCEDIRS) +
             getCanonicalPathList(CONFIG_EXAMPLEDIRS);
 
-        for (const auto &dir : dirs)
-            result += getFilesHere(dir, "*." + ext, location());
+        DirectoryWalker walker("*." + ext, {}, {});
+        result += walker.walk(dirs, DirectoryWalker::PathStyle::Canonical);
         result.removeDuplicates();
         m_includeFilesMap.insert(ext, result);
     }
@@ -769,8 +826,8 @@ QStringList Config::getAllFiles(const QString &filesVar, const QString &dirsVar,
 
     const QString nameFilter = m_configVars.value(filesVar + dot + CONFIG_FILEEXTENSIONS).asString();
 
-    for (const auto &dir : dirs)
-        result += getFilesHere(dir, nameFilter, location(), excludedDirs, excludedFiles);
+    DirectoryWalker walker(nameFilter, excludedDirs, excludedFiles);
+    result += walker.walk(dirs, DirectoryWalker::PathStyle::Canonical);
     return result;
 }
 
@@ -781,8 +838,8 @@ QStringList Config::getExampleQdocFiles(const QSet<QString> &excludedDirs,
     const QStringList dirs = getCanonicalPathList("exampledirs");
     const QString nameFilter = " *.qdoc";
 
-    for (const auto &dir : dirs)
-        result += getFilesHere(dir, nameFilter, location(), excludedDirs, excludedFiles);
+    DirectoryWalker walker(nameFilter, excludedDirs, excludedFiles);
+    result += walker.walk(dirs, DirectoryWalker::PathStyle::Canonical);
     return result;
 }
 
@@ -793,8 +850,8 @@ QStringList Config::getExampleImageFiles(const QSet<QString> &excludedDirs,
     const QStringList dirs = getCanonicalPathList("exampledirs");
     const QString nameFilter = m_configVars.value(CONFIG_EXAMPLES + dot + CONFIG_IMAGEEXTENSIONS).asString();
 
-    for (const auto &dir : dirs)
-        result += getFilesHere(dir, nameFilter, location(), excludedDirs, excludedFiles);
+    DirectoryWalker walker(nameFilter, excludedDirs, excludedFiles);
+    result += walker.walk(dirs, DirectoryWalker::PathStyle::Canonical);
     return result;
 }
 
@@ -941,6 +998,10 @@ QString Config::findFile(const Location &location, const QStringList &files,
   \a userFriendlySourceFilePath. \a location is for identifying
   the file and line number where a qdoc error occurred. The
   constructed output file name is returned.
+
+  The copy is made in the background, and only if the output file
+  isn't already a copy of the source. Failures to write the output
+  file are reported by finishCopyingFiles().
  */
 QString Config::copyFile(const Location &location, const QString &sourceFilePath,
                          const QString &userFriendlySourceFilePath, const QString &targetDirPath)
@@ -954,13 +1015,6 @@ QString Config::copyFile(const Location &location, const QString &sourceFilePath
     // copying files into an appropriate subsystem and have a better
     // understanding of call-site usages.
 
-    QFile inFile(sourceFilePath);
-    if (!inFile.open(QFile::ReadOnly)) {
-        location.warning(QStringLiteral("Cannot open input file for copy: '%1': %2")
-                                 .arg(sourceFilePath, inFile.errorString()));
-        return QString();
-    }
-
     // TODO: [non-canonical-representation]
     // Similar to other part of QDoc, we do a series of non-intuitive
     // checks to canonicalize some multi-format parameter into
@@ -1001,31 +1055,61 @@ QString Config::copyFile(const Location &location, const QString &sourceFilePath
         outFileName = outFileNameInfo.fileName();
 
     outFileName = targetDirPath + "/" + outFileName;
-    QDir targetDir(targetDirPath);
-    if (!targetDir.exists())
-        targetDir.mkpath(".");
 
-    QFile outFile(outFileName);
-    if (!outFile.open(QFile::WriteOnly)) {
-        // TODO: [uncrentralized-warning]
-        location.warning(QStringLiteral("Cannot open output file for copy: '%1': %2")
-                                 .arg(outFileName, outFile.errorString()));
+    // Each target is copied at most once per run, unless it is to be
+    // replaced by a different file.
+    auto copied = m_copiedFiles.constFind(outFileName);
+    if (copied != m_copiedFiles.cend() && *copied == sourceFilePath)
+        return outFileName;
+
+    QFile inFile(sourceFilePath);
+    if (!inFile.open(QFile::ReadOnly)) {
+        location.warning(QStringLiteral("Cannot open input file for copy: '%1': %2")
+                                 .arg(sourceFilePath, inFile.errorString()));
         return QString();
     }
+    m_copiedFiles.insert(outFileName, sourceFilePath);
 
-    // TODO: There shouldn't be any particular advantage to copying
-    // the file by readying its content and writing it compared to
-    // asking the underlying system to do the copy for us.
-    // Consider simplifying this part by avoiding doing the manual
-    // work ourselves.
+    if (!m_copyTargetDirs.contains(targetDirPath)) {
+        QDir targetDir(targetDirPath);
+        if (!targetDir.exists())
+            targetDir.mkpath(".");
+        m_copyTargetDirs.insert(targetDirPath);
+    }
 
-    char buffer[1024];
-    qsizetype len;
-    while ((len = inFile.read(buffer, sizeof(buffer))) > 0)
-        outFile.write(buffer, len);
+    fileCopier->pool.start([location, sourceFilePath, outFileName] {
+        const QString error = copyIfChanged(sourceFilePath, outFileName);
+        if (error.isEmpty())
+            return;
+        // TODO: [uncrentralized-warning]
+        QMutexLocker locker(&fileCopier->mutex);
+        fileCopier->failures.append(
+                { location,
+                  QStringLiteral("Cannot open output file for copy: '%1': %2")
+                          .arg(outFileName, error) });
+    });
     return outFileName;
 }
 
+/*!
+  Waits until the files passed to copyFile() have been copied, and
+  reports the copies that failed.
+ */
+void Config::finishCopyingFiles()
+{
+    if (!fileCopier.exists())
+        return;
+
+    fileCopier->pool.waitForDone();
+    QList<std::pair<Location, QString>> failures;
+    {
+        QMutexLocker locker(&fileCopier->mutex);
+        failures.swap(fileCopier->failures);
+    }
+    for (const auto &[location, message] : std::as_const(failures))
+        location.warning(message);
+}
+
 /*!
   Finds the largest unicode digit in \a value in the range
   1..7 and returns it.
@@ -1342,42 +1426,26 @@ bool Config::isFileExcluded(const QString &fileName, const QSet<QString> &exclud
     return excludedFiles.contains(fileName);
 }
 
+/*!
+  Returns the paths of the files below \a uncleanDir whose names
+  match \a nameFilter, a space-separated list of wildcard patterns.
+  The directories in \a excludedDirs are avoided. The files in
+  \a excludedFiles are not included in the return list.
+
+  If \a location is empty, directory paths are only cleaned;
+  otherwise, they are canonicalized.
+
+  \sa DirectoryWalker
+ */
 QStringList Config::getFilesHere(const QString &uncleanDir, const QString &nameFilter,
                                  const Location &location, const QSet<QString> &excludedDirs,
                                  const QSet<QString> &excludedFiles)
 {
     // TODO: Understand why location is used to branch the
     // canonicalization and why the two different methods are used.
-    QString dir =
-            location.isEmpty() ? QDir::cleanPath(uncleanDir) : QDir(uncleanDir).canonicalPath();
-    QStringList result;
-    if (excludedDirs.contains(dir))
-        return result;
-
-    QDir dirInfo(dir);
-
-    dirInfo.setNameFilters(nameFilter.split(QLatin1Char(' ')));
-    dirInfo.setSorting(QDir::Name);
-    dirInfo.setFilter(QDir::Files);
-    QStringList fileNames = dirInfo.entryList();
-    for (const auto &file : std::as_const(fileNames)) {
-        // TODO: Understand if this is needed and, should it be, if it
-        // is indeed the only case that should be considered.
-        if (!file.startsWith(QLatin1Char('~'))) {
-            QString s = dirInfo.filePath(file);
-            QString c = QDir::cleanPath(s);
-            if (!isFileExcluded(c, excludedFiles))
-                result.append(c);
-        }
-    }
-
-    dirInfo.setNameFilters(QStringList(QLatin1String("*")));
-    dirInfo.setFilter(QDir::Dirs | QDir::NoDotAndDotDot);
-    fileNames = dirInfo.entryList();
-    for (const auto &file : fileNames)
-        result += getFilesHere(dirInfo.filePath(file), nameFilter, location, excludedDirs,
-                               excludedFiles);
-    return result;
+    const auto style = location.isEmpty() ? DirectoryWalker::PathStyle::Clean
+                                          : DirectoryWalker::PathStyle::Canonical;
+    return DirectoryWalker(nameFilter, excludedDirs, excludedFiles).walk({ uncleanDir }, style);
 }
 
 /*!
@@ -8,6 +8,7 @@
 #include "qdoccommandlineparser.h"
 #include "singleton.h"
 
+#include <QtCore/qhash.h>
 #include <QtCore/qmap.h>
 #include <QtCore/qset.h>
 #include <QtCore/qstack.h>
@@ -155,6 +156,7 @@ public:
     static QString copyFile(const Location &location, const QString &sourceFilePath,
                             const QString &userFriendlySourceFilePath,
                             const QString &targetDirPath);
+    static void finishCopyingFiles();
     static int numParams(const QString &value);
     static void pushWorkingDir(const QString &dir);
     static void popWorkingDir();
@@ -232,6 +234,8 @@ private:
     static QMap<QString, QString> m_extractedDirs;
     static QStack<QString> m_workingDirs;
     static QMap<QString, QStringList> m_includeFilesMap;
+    static QHash<QString, QString> m_copiedFiles;
+    static QSet<QString> m_copyTargetDirs;
     QDocCommandLineParser m_parser {};
 
     QDocPass m_qdocPass { Neither };
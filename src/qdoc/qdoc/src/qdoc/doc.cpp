@@ -362,6 +362,7 @@ void Doc::terminate()
 {
     m_utilities.cmdHash.clear();
     m_utilities.macroHash.clear();
+    m_utilities.includeFiles.clear();
 }
 
 /*!
@@ -881,7 +881,7 @@ qsizetype DocBookGenerator::generateAtom(const Atom *atom, const Node *relative,
         m_inBlockquote = false;
         break;
     case Atom::RawString: {
-        m_writer->device()->write(atom->string().toUtf8());
+        m_writer->writeRawData(atom->string().toUtf8());
     }
         break;
     case Atom::SectionLeft:
@@ -2173,9 +2173,10 @@ void DocBookGenerator::generateRequisites(const Aggregate *aggregate)
     // Generate the requisites first separately: if some of them are generated, output them in a wrapper.
     // This complexity is required to ensure the DocBook file is valid: an empty list is not valid. It is not easy
     // to write a truly comprehensive condition.
-    QXmlStreamWriter* oldWriter = m_writer;
-    QString output;
-    m_writer = new QXmlStreamWriter(&output);
+    XmlWriter *oldWriter = m_writer;
+    QByteArray output;
+    m_writer = new XmlWriter(&output);
+    m_writer->declareNamespaces(*oldWriter);
 
     // Includes.
     if (aggregate->includeFile()) generateRequisite("Header", *aggregate->includeFile());
@@ -2263,24 +2264,12 @@ void DocBookGenerator::generateRequisites(const Aggregate *aggregate)
     m_writer = oldWriter;
 
     if (!output.isEmpty()) {
-        // Namespaces are mangled in this output, because QXmlStreamWriter doesn't know about them. (Letting it know
-        // would imply generating the xmlns declaration one more time.)
-        static const QRegularExpression xmlTag(R"(<(/?)n\d+:)"); // Only for DocBook tags.
-        static const QRegularExpression xmlnsDocBookDefinition(R"( xmlns:n\d+=")" + QString{dbNamespace} + "\"");
-        static const QRegularExpression xmlnsXLinkDefinition(R"( xmlns:n\d+=")" + QString{xlinkNamespace} + "\"");
-        static const QRegularExpression xmlAttr(R"( n\d+:)"); // Only for XLink attributes.
-        // Space at the beginning!
-        const QString cleanOutput = output.replace(xmlTag, R"(<\1db:)")
-            .replace(xmlnsDocBookDefinition, "")
-            .replace(xmlnsXLinkDefinition, "")
-            .replace(xmlAttr, " xlink:");
-
         m_writer->writeStartElement(dbNamespace, "variablelist");
         if (m_useITS)
             m_writer->writeAttribute(itsNamespace, "translate", "no");
         newLine();
 
-        m_writer->device()->write(cleanOutput.toUtf8());
+        m_writer->writeRawData(output);
 
         m_writer->writeEndElement(); // variablelist
         newLine();
@@ -2844,7 +2833,7 @@ void DocBookGenerator::generateExampleFilePage(const Node *node, ResolvedFile re
     const auto en = static_cast<const ExampleNode *>(node);
 
     // Store current (active) writer
-    QXmlStreamWriter *currentWriter = m_writer;
+    XmlWriter *currentWriter = m_writer;
     m_writer = startDocument(en, resolved_file.get_query());
     generateHeader(en->fullTitle(), en->subtitle(), en);
 
@@ -2937,12 +2926,11 @@ void DocBookGenerator::generateAlsoList(const Node *node)
   Open a new file to write XML contents, including the DocBook
   opening tag.
  */
-QXmlStreamWriter *DocBookGenerator::startGenericDocument(const Node *node, const QString &fileName)
+XmlWriter *DocBookGenerator::startGenericDocument(const Node *node, const QString &fileName)
 {
     Q_ASSERT(node->isPageNode());
     QFile *outFile = openSubPageFile(static_cast<const PageNode*>(node), fileName);
-    m_writer = new QXmlStreamWriter(outFile);
-    m_writer->setAutoFormatting(false); // We need a precise handling of line feeds.
+    m_writer = new XmlWriter(outFile);
 
     m_writer->writeStartDocument();
     newLine();
@@ -2964,7 +2952,7 @@ QXmlStreamWriter *DocBookGenerator::startGenericDocument(const Node *node, const
     return m_writer;
 }
 
-QXmlStreamWriter *DocBookGenerator::startDocument(const Node *node)
+XmlWriter *DocBookGenerator::startDocument(const Node *node)
 {
     m_hasSection = false;
     refMap.clear();
@@ -2973,7 +2961,7 @@ QXmlStreamWriter *DocBookGenerator::startDocument(const Node *node)
     return startGenericDocument(node, fileName);
 }
 
-QXmlStreamWriter *DocBookGenerator::startDocument(const ExampleNode *en, const QString &file)
+XmlWriter *DocBookGenerator::startDocument(const ExampleNode *en, const QString &file)
 {
     m_hasSection = false;
 
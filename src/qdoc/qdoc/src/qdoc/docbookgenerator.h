@@ -8,10 +8,10 @@
 #include "codemarker.h"
 #include "config.h"
 #include "xmlgenerator.h"
+#include "xmlwriter.h"
 #include "filesystem/fileresolver.h"
 
 #include <QtCore/qhash.h>
-#include <QtCore/qxmlstream.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -69,9 +69,9 @@ private:
 
     enum GeneratedListType { Auto, AutoSection, ItemizedList };
 
-    QXmlStreamWriter *startDocument(const Node *node);
-    QXmlStreamWriter *startDocument(const ExampleNode *en, const QString &file);
-    QXmlStreamWriter *startGenericDocument(const Node *node, const QString &fileName);
+    XmlWriter *startDocument(const Node *node);
+    XmlWriter *startDocument(const ExampleNode *en, const QString &file);
+    XmlWriter *startGenericDocument(const Node *node, const QString &fileName);
     void endDocument();
 
     void generateAnnotatedList(const Node *relative, const NodeList &nodeList,
@@ -159,7 +159,7 @@ private:
     QString m_projectDescription {};
     QString m_naturalLanguage {};
     QString m_buildVersion {};
-    QXmlStreamWriter *m_writer { nullptr };
+    XmlWriter *m_writer { nullptr };
     bool m_useDocBook52 { false }; // Enable tags from DocBook 5.2. Also called "extensions".
     bool m_useITS { false }; // Enable ITS attributes for parts that should not be translated.
 
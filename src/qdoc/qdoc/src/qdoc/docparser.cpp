@@ -14,6 +14,7 @@
 #include <QtCore/qregularexpression.h>
 #include <QtCore/qtextstream.h>
 
+#include <algorithm>
 #include <cctype>
 #include <climits>
 #include <functional>
@@ -1114,10 +1115,7 @@ void DocParser::parse(const QString &source, DocPrivate *docPrivate,
                                                        "syntax definitions"));
                             } else {
                                 QString expanded = expandMacroToString(cmdStr, macro);
-                                m_input.replace(m_backslashPosition,
-                                                m_endPosition - m_backslashPosition, expanded);
-                                m_inputLength = m_input.size();
-                                m_position = m_backslashPosition;
+                                spliceInput(m_backslashPosition, m_endPosition, expanded);
                             }
                         }
                     } else if (isAutoLinkString(cmdStr)) {
@@ -1400,72 +1398,108 @@ void DocParser::insertKeyword(const QString &keyword)
     m_private->extra->m_keywords.append(m_private->m_text.lastAtom());
 }
 
+/*!
+  Returns the include file \a fileName, which is looked up and read
+  only the first time it is included in a run. Its lines and the
+  indexes of its \c{//!} marker lines are computed at the same time.
+ */
+static const IncludeFile &includeFile(const QString &fileName, DocUtilities &utilities)
+{
+    auto it = utilities.includeFiles.find(fileName);
+    if (it != utilities.includeFiles.end())
+        return *it;
+
+    IncludeFile file;
+    file.filePath = Config::instance().getIncludeFilePath(fileName);
+    if (!file.filePath.isEmpty()) {
+        QFile inFile(file.filePath);
+        if (inFile.open(QFile::ReadOnly)) {
+            file.isOpen = true;
+            QTextStream inStream(&inFile);
+            file.content = inStream.readAll();
+            file.lines = file.content.split(QLatin1Char('\n'));
+            for (qsizetype i = 0; i < file.lines.size(); ++i) {
+                if (QStringView{file.lines.at(i)}.trimmed().startsWith(QLatin1String("//!")))
+                    file.markerLines.append(i);
+            }
+        }
+    }
+    return *utilities.includeFiles.insert(fileName, std::move(file));
+}
+
 void DocParser::include(const QString &fileName, const QString &identifier, const QStringList &parameters)
 {
     if (location().depth() > 16)
         location().fatal(QStringLiteral("Too many nested '\\%1's").arg(cmdName(CMD_INCLUDE)));
-    QString filePath = Config::instance().getIncludeFilePath(fileName);
+    const IncludeFile &file = includeFile(fileName, s_utilities);
+    const QString &filePath = file.filePath;
     if (filePath.isEmpty()) {
         location().warning(QStringLiteral("Cannot find qdoc include file '%1'").arg(fileName));
+    } else if (!file.isOpen) {
+        location().warning(QStringLiteral("Cannot open qdoc include file '%1'").arg(filePath));
     } else {
-        QFile inFile(filePath);
-        if (!inFile.open(QFile::ReadOnly)) {
-            location().warning(
-                    QStringLiteral("Cannot open qdoc include file '%1'").arg(filePath));
+        location().push(fileName);
+
+        if (identifier.isEmpty()) {
+            QString includedContent = file.content;
+            expandArgumentsInString(includedContent, parameters);
+            m_openedInputs.push(spliceInput(m_position, m_position, includedContent));
         } else {
-            location().push(fileName);
-            QTextStream inStream(&inFile);
-            QString includedContent = inStream.readAll();
-            inFile.close();
+            auto containsIdentifier = [&file, &identifier](qsizetype line) {
+                return file.lines.at(line).contains(identifier);
+            };
+            const auto begin = std::find_if(file.markerLines.cbegin(), file.markerLines.cend(),
+                                            containsIdentifier);
+            if (begin == file.markerLines.cend() || *begin == file.lines.size() - 1) {
+                location().warning(
+                        QStringLiteral("Cannot find '%1' in '%2'").arg(identifier, filePath));
+                return;
+            }
+            const auto end = std::find_if(begin + 1, file.markerLines.cend(), containsIdentifier);
+            const qsizetype endLine = end == file.markerLines.cend() ? file.lines.size() : *end;
 
-            if (identifier.isEmpty()) {
-                expandArgumentsInString(includedContent, parameters);
-                m_input.insert(m_position, includedContent);
-                m_inputLength = m_input.size();
-                m_openedInputs.push(m_position + includedContent.size());
+            QString result;
+            for (qsizetype i = *begin + 1; i < endLine; ++i)
+                result += file.lines.at(i) + QLatin1Char('\n');
+
+            expandArgumentsInString(result, parameters);
+            if (result.isEmpty()) {
+                location().warning(QStringLiteral("Empty qdoc snippet '%1' in '%2'")
+                                           .arg(identifier, filePath));
             } else {
-                QStringList lineBuffer = includedContent.split(QLatin1Char('\n'));
-                qsizetype bufLen{lineBuffer.size()};
-                qsizetype i;
-                QStringView trimmedLine;
-                for (i = 0; i < bufLen; ++i) {
-                    trimmedLine = QStringView{lineBuffer[i]}.trimmed();
-                    if (trimmedLine.startsWith(QLatin1String("//!")) &&
-                        trimmedLine.contains(identifier))
-                        break;
-                }
-                if (i < bufLen - 1) {
-                    ++i;
-                } else {
-                    location().warning(
-                            QStringLiteral("Cannot find '%1' in '%2'").arg(identifier, filePath));
-                    return;
-                }
-                QString result;
-                do {
-                    trimmedLine = QStringView{lineBuffer[i]}.trimmed();
-                    if (trimmedLine.startsWith(QLatin1String("//!")) &&
-                        trimmedLine.contains(identifier))
-                        break;
-                    else
-                        result += lineBuffer[i] + QLatin1Char('\n');
-                    ++i;
-                } while (i < bufLen);
-
-                expandArgumentsInString(result, parameters);
-                if (result.isEmpty()) {
-                    location().warning(QStringLiteral("Empty qdoc snippet '%1' in '%2'")
-                                               .arg(identifier, filePath));
-                } else {
-                    m_input.insert(m_position, result);
-                    m_inputLength = m_input.size();
-                    m_openedInputs.push(m_position + result.size());
-                }
+                m_openedInputs.push(spliceInput(m_position, m_position, result));
             }
         }
     }
 }
 
+/*!
+  Replaces the input between \a from and \a to with \a text, and moves
+  the current position to the start of \a text. Returns the position
+  just past \a text.
+
+  Input before \a from has been parsed already. If it is at least as
+  long as \a text, \a text is written over the end of it, right before
+  \a to, so that the rest of the input doesn't have to be moved. The
+  current location is advanced to \a from first, so that it continues
+  through \a text as if it had been inserted there.
+ */
+qsizetype DocParser::spliceInput(qsizetype from, qsizetype to, const QString &text)
+{
+    m_position = from;
+    location();
+    if (text.size() <= to && m_cachedPosition == from) {
+        m_position = to - text.size();
+        std::copy(text.cbegin(), text.cend(), m_input.begin() + m_position);
+        m_cachedPosition = m_position;
+        return to;
+    }
+
+    m_input.replace(from, to - from, text);
+    m_inputLength = m_input.size();
+    return from + text.size();
+}
+
 void DocParser::startFormat(const QString &format, int cmd)
 {
     enterPara();
@@ -56,6 +56,7 @@ private:
     void insertTarget(const QString &target);
     void insertKeyword(const QString &keyword);
     void include(const QString &fileName, const QString &identifier, const QStringList &parameters);
+    qsizetype spliceInput(qsizetype from, qsizetype to, const QString &text);
     void startFormat(const QString &format, int cmd);
     bool openCommand(int cmd);
     bool closeCommand(int endCmd);
@@ -8,7 +8,9 @@
 
 #include <QtCore/qglobal.h>
 #include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
 #include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
 #include <QtCore/qmap.h>
 
 QT_BEGIN_NAMESPACE
@@ -16,11 +18,26 @@ QT_BEGIN_NAMESPACE
 typedef QHash<QString, int> QHash_QString_int;
 typedef QHash<QString, Macro> QHash_QString_Macro;
 
+/*
+    A file included with \include or \input, as read the first time
+    it was included. markerLines holds the indexes of the lines that
+    are //! snippet markers.
+*/
+struct IncludeFile
+{
+    QString filePath {};
+    bool isOpen { false };
+    QString content {};
+    QStringList lines {};
+    QList<qsizetype> markerLines {};
+};
+
 struct DocUtilities : public Singleton<DocUtilities>
 {
 public:
     QHash_QString_int cmdHash;
     QHash_QString_Macro macroHash;
+    QHash<QString, IncludeFile> includeFiles;
 };
 
 QT_END_NAMESPACE
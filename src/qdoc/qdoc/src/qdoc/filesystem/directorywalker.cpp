@@ -0,0 +1,235 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "directorywalker.h"
+
+#include <QtCore/qdatetime.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qthreadpool.h>
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/*!
+ * \class DirectoryWalker
+ * \brief Collects the files below a set of root directories whose
+ * names match a name filter, for example the files QDoc should parse.
+ *
+ * Directories are listed concurrently on a thread pool. Directories
+ * in the set of excluded directories are pruned before they are
+ * listed, and the name filter and the excluded files are applied
+ * while listing, so that only the resulting paths are collected.
+ *
+ * The result does not depend on the order in which the directories
+ * are listed: for each root directory, in the given order, it
+ * contains the files in that directory sorted by name, followed by
+ * the files in each of its subdirectories, sorted by name, in turn.
+ *
+ * Hidden files and directories, and files whose name starts with a
+ * tilde, are ignored.
+ *
+ * Directory listings are kept for the lifetime of the process and
+ * reused as long as the modification time of the directory is
+ * unchanged, as QDoc enumerates some directories, such as the
+ * example directories, several times in a run.
+ */
+
+struct DirectoryWalker::Directory {
+    explicit Directory(QString path) : path{std::move(path)} {}
+
+    QString path;
+    QStringList files;
+    std::vector<std::unique_ptr<Directory>> subdirectories;
+};
+
+namespace {
+
+struct Entry {
+    QString name;
+    bool is_directory;
+    bool is_symlink;
+};
+
+/*!
+ * \internal
+ *
+ * Returns the non-hidden files and directories in \a path, sorted by
+ * name.
+ */
+QList<Entry> list_directory(const QString& path)
+{
+    struct Listing {
+        QDateTime last_modified;
+        QList<Entry> entries;
+    };
+    static QMutex mutex;
+    static QHash<QString, Listing> cache;
+
+    const QDateTime last_modified = QFileInfo(path).lastModified();
+    {
+        QMutexLocker locker(&mutex);
+        auto it = cache.constFind(path);
+        if (it != cache.constEnd() && it->last_modified == last_modified)
+            return it->entries;
+    }
+
+    QDir dir(path);
+    dir.setFilter(QDir::Files | QDir::Dirs | QDir::NoDotAndDotDot);
+    dir.setSorting(QDir::Name);
+
+    QList<Entry> entries;
+    const QFileInfoList infos = dir.entryInfoList();
+    entries.reserve(infos.size());
+    for (const QFileInfo& info : infos)
+        entries.append(Entry{info.fileName(), info.isDir(), info.isSymLink()});
+
+    QMutexLocker locker(&mutex);
+    cache.insert(path, Listing{last_modified, entries});
+    return entries;
+}
+
+QRegularExpression wildcard(const QString& pattern)
+{
+    QRegularExpression re(QRegularExpression::wildcardToRegularExpression(pattern),
+                          QRegularExpression::CaseInsensitiveOption);
+    re.optimize();
+    return re;
+}
+
+} // namespace
+
+/*!
+ * Constructs a DirectoryWalker that collects the files matching \a
+ * name_filter, a space-separated list of wildcard patterns.
+ *
+ * Directories whose path is in \a excluded_directories are skipped,
+ * together with all their subdirectories. Files whose path is in \a
+ * excluded_files, or matches one of the wildcard patterns in it, are
+ * left out.
+ */
+DirectoryWalker::DirectoryWalker(const QString& name_filter, QSet<QString> excluded_directories,
+                                 const QSet<QString>& excluded_files)
+    : excluded_directories{std::move(excluded_directories)}, excluded_files{excluded_files}
+{
+    for (const QString& pattern : name_filter.split(QLatin1Char(' ')))
+        name_filters.append(wildcard(pattern));
+
+    for (const QString& entry : excluded_files) {
+        if (entry.contains(QLatin1Char('*')) || entry.contains(QLatin1Char('?'))) {
+            QRegularExpression re(QRegularExpression::wildcardToRegularExpression(entry));
+            re.optimize();
+            excluded_file_patterns.append(re);
+        }
+    }
+}
+
+/*!
+ * Returns the paths of the matching files below \a root_directories.
+ *
+ * With \a style PathStyle::Canonical, directory paths are canonical,
+ * with symbolic links resolved, and that is also the form in which
+ * they are compared to the excluded directories. With
+ * PathStyle::Clean, paths are only cleaned.
+ *
+ * Root directories that do not exist are ignored.
+ */
+QStringList DirectoryWalker::walk(const QStringList& root_directories, PathStyle style) const
+{
+    std::vector<std::unique_ptr<Directory>> roots;
+    roots.reserve(root_directories.size());
+    for (const QString& root : root_directories) {
+        QString path = style == PathStyle::Clean ? QDir::cleanPath(root)
+                                                 : QDir(root).canonicalPath();
+        if (!path.isEmpty() && !excluded_directories.contains(path))
+            roots.push_back(std::make_unique<Directory>(std::move(path)));
+    }
+
+    QThreadPool pool;
+    for (const auto& root : roots) {
+        Directory* directory = root.get();
+        pool.start([this, &pool, directory, style] { visit(pool, directory, style); });
+    }
+    pool.waitForDone();
+
+    QStringList result;
+    for (const auto& root : roots)
+        collect(*root, result);
+    return result;
+}
+
+/*!
+ * \internal
+ *
+ * Appends the files in \a directory and its subdirectories to \a
+ * result, in walk order.
+ */
+void DirectoryWalker::collect(const Directory& directory, QStringList& result)
+{
+    result += directory.files;
+    for (const auto& subdirectory : directory.subdirectories)
+        collect(*subdirectory, result);
+}
+
+/*!
+ * \internal
+ *
+ * Lists \a directory, collects its matching files, and schedules the
+ * subdirectories that are not excluded on \a pool.
+ */
+void DirectoryWalker::visit(QThreadPool& pool, Directory* directory, PathStyle style) const
+{
+    const QString prefix = directory->path + QLatin1Char('/');
+    for (const Entry& entry : list_directory(directory->path)) {
+        if (entry.is_directory) {
+            QString path = QDir::cleanPath(prefix + entry.name);
+            if (style == PathStyle::Canonical && entry.is_symlink)
+                path = QFileInfo(path).canonicalFilePath();
+            if (!path.isEmpty() && !excluded_directories.contains(path))
+                directory->subdirectories.push_back(std::make_unique<Directory>(std::move(path)));
+        } else if (!entry.name.startsWith(QLatin1Char('~')) && matches_name_filter(entry.name)) {
+            QString path = QDir::cleanPath(prefix + entry.name);
+            if (!is_excluded_file(path))
+                directory->files.append(std::move(path));
+        }
+    }
+
+    for (const auto& subdirectory : directory->subdirectories) {
+        Directory* child = subdirectory.get();
+        pool.start([this, &pool, child, style] { visit(pool, child, style); });
+    }
+}
+
+/*!
+ * \internal
+ *
+ * Returns \c true if \a file_name matches one of the patterns of the
+ * name filter.
+ */
+bool DirectoryWalker::matches_name_filter(const QString& file_name) const
+{
+    return std::any_of(name_filters.cbegin(), name_filters.cend(),
+                       [&file_name](const QRegularExpression& re) {
+                           return re.match(file_name).hasMatch();
+                       });
+}
+
+/*!
+ * \internal
+ *
+ * Returns \c true if \a file_path is one of the excluded files or
+ * matches one of the excluded wildcard patterns.
+ */
+bool DirectoryWalker::is_excluded_file(const QString& file_path) const
+{
+    if (excluded_files.contains(file_path))
+        return true;
+    return std::any_of(excluded_file_patterns.cbegin(), excluded_file_patterns.cend(),
+                       [&file_path](const QRegularExpression& re) {
+                           return re.match(file_path).hasMatch();
+                       });
+}
@@ -0,0 +1,35 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#pragma once
+
+#include <QtCore/qlist.h>
+#include <QtCore/qregularexpression.h>
+#include <QtCore/qset.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
+
+class QThreadPool;
+
+class DirectoryWalker {
+public:
+    enum class PathStyle { Clean, Canonical };
+
+    DirectoryWalker(const QString& name_filter, QSet<QString> excluded_directories,
+                    const QSet<QString>& excluded_files);
+
+    [[nodiscard]] QStringList walk(const QStringList& root_directories, PathStyle style) const;
+
+private:
+    struct Directory;
+
+    void visit(QThreadPool& pool, Directory* directory, PathStyle style) const;
+    static void collect(const Directory& directory, QStringList& result);
+    [[nodiscard]] bool matches_name_filter(const QString& file_name) const;
+    [[nodiscard]] bool is_excluded_file(const QString& file_path) const;
+
+    QList<QRegularExpression> name_filters;
+    QSet<QString> excluded_directories;
+    QSet<QString> excluded_files;
+    QList<QRegularExpression> excluded_file_patterns;
+};
@@ -1644,6 +1644,7 @@ void Generator::generateDocs()
 {
     s_currentGenerator = this;
     generateDocumentation(m_qdb->primaryTreeRoot());
+    Config::finishCopyingFiles();
 }
 
 Generator *Generator::generatorForFormat(const QString &format)
@@ -2106,6 +2107,8 @@ void Generator::generateEnumValuesForQmlProperty(const Node *node, CodeMarker *m
 
 void Generator::terminate()
 {
+    Config::finishCopyingFiles();
+
     for (const auto &generator : std::as_const(s_generators)) {
         if (s_outputFormats.contains(generator->format()))
             generator->terminateGenerator();
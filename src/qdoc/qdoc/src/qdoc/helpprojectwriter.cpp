@@ -15,8 +15,12 @@
 #include "node.h"
 #include "qdocdatabase.h"
 #include "typedefnode.h"
+#ifndef QDOC_NO_QCH
+#include "qchwriter.h"
+#endif
 
 #include <QtCore/qhash.h>
+#include <QtCore/qprocess.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -54,6 +58,17 @@ void HelpProjectWriter::reset(const QString &defaultFileName, Generator *g)
         project.m_virtualFolder = config.get(prefix + "virtualFolder").asString();
         project.m_version = config.get(CONFIG_VERSION).asString();
         project.m_fileName = config.get(prefix + "file").asString();
+        project.m_qchFileName = config.get(prefix + "qchFile").asString();
+#ifdef QDOC_NO_QCH
+        if (!project.m_qchFileName.isEmpty()) {
+            config.location().warning(
+                    u"This QDoc cannot write %1; writing %2 instead"_s.arg(
+                            project.m_qchFileName, prefix + "file"));
+            project.m_qchFileName.clear();
+        }
+#endif
+        // The .qhp file is only left out if a .qch file is written instead
+        project.m_writeQhp = !project.m_fileName.isEmpty() || project.m_qchFileName.isEmpty();
         if (project.m_fileName.isEmpty())
             project.m_fileName = defaultFileName;
         project.m_extraFiles = config.get(prefix + "extraFiles").asStringSet();
@@ -160,9 +175,22 @@ void HelpProjectWriter::addExtraFile(const QString &file)
         project.m_extraFiles.insert(file);
 }
 
-Keyword HelpProjectWriter::keywordDetails(const Node *node) const
+/*!
+    Returns the full document location of \a node. Locations are
+    computed once per node, as keywords, table of contents entries,
+    and member lists of a project all refer to them.
+ */
+const QString &HelpProjectWriter::documentLocation(const Node *node)
+{
+    auto it = m_documentLocations.find(node);
+    if (it == m_documentLocations.end())
+        it = m_documentLocations.insert(node, m_gen->fullDocumentLocation(node));
+    return it.value();
+}
+
+Keyword HelpProjectWriter::keywordDetails(const Node *node)
 {
-    QString ref = m_gen->fullDocumentLocation(node);
+    const QString &ref = documentLocation(node);
 
     if (node->parent() && !node->parent()->name().isEmpty()) {
         QString name = (node->isEnumType() || node->isTypedef())
@@ -220,15 +248,16 @@ bool HelpProjectWriter::generateSection(HelpProject &project, QXmlStreamWriter &
     // Only add nodes to the set for each subproject if they match a selector.
     // Those that match will be listed in the table of contents.
 
-    for (int i = 0; i < project.m_subprojects.size(); i++) {
-        SubProject subproject = project.m_subprojects[i];
+    // Modify the subprojects in place; a copy would share the node hash
+    // and cause it to detach on every insertion.
+    for (SubProject &subproject : project.m_subprojects) {
         // No selectors: accept all nodes.
         if (subproject.m_selectors.isEmpty()) {
-            project.m_subprojects[i].m_nodes[objName] = node;
+            subproject.m_nodes[objName] = node;
         } else if (subproject.m_selectors.contains(node->nodeType())) {
             // Add all group members for '[group|module|qmlmodule]:name' selector
             if (node->isCollectionNode()) {
-                if (project.m_subprojects[i].m_groups.contains(node->name().toLower())) {
+                if (subproject.m_groups.contains(node->name().toLower())) {
                     const auto *cn = static_cast<const CollectionNode *>(node);
                     const auto members = cn->members();
                     for (const Node *m : members) {
@@ -236,34 +265,34 @@ bool HelpProjectWriter::generateSection(HelpProject &project, QXmlStreamWriter &
                             continue;
                         QString memberName =
                                 m->isTextPageNode() ? m->fullTitle() : m->fullDocumentName();
-                        project.m_subprojects[i].m_nodes[memberName] = m;
+                        subproject.m_nodes[memberName] = m;
                     }
                     continue;
-                } else if (!project.m_subprojects[i].m_groups.isEmpty()) {
+                } else if (!subproject.m_groups.isEmpty()) {
                     continue; // Node does not represent specified group(s)
                 }
             } else if (node->isTextPageNode()) {
                 if (node->isExternalPage() || node->fullTitle().isEmpty())
                     continue;
             }
-            project.m_subprojects[i].m_nodes[objName] = node;
+            subproject.m_nodes[objName] = node;
         }
     }
 
     auto appendDocKeywords = [&](const Node *n) {
-        for (const auto *kw : n->doc().keywords()) {
-                if (!kw->string().isEmpty()) {
-                    QStringList ref_parts = m_gen->fullDocumentLocation(n).split('#'_L1);
-                    // Use keyword's custom anchor if it has one
-                    if (kw->count() > 1) {
-                        if (ref_parts.count() > 1)
-                            ref_parts.pop_back();
-                        ref_parts << kw->string(1);
-                    }
-                    project.m_keywords.append(Keyword(kw->string(), kw->string(),
-                            ref_parts.join('#'_L1)));
-                }
-            }
+        const auto keywords = n->doc().keywords();
+        if (keywords.isEmpty())
+            return;
+        const QString &ref = documentLocation(n);
+        const qsizetype anchor = ref.lastIndexOf('#'_L1);
+        const QString page = anchor == -1 ? ref : ref.left(anchor);
+        for (const auto *kw : keywords) {
+            if (kw->string().isEmpty())
+                continue;
+            // Use keyword's custom anchor if it has one
+            QString kwRef = kw->count() > 1 ? page + '#'_L1 + kw->string(1) : ref;
+            project.m_keywords.append(Keyword(kw->string(), kw->string(), std::move(kwRef)));
+        }
     };
     // Unseen group nodes require no further processing as they have no documentation
     if (unseenGroup)
@@ -290,6 +319,7 @@ bool HelpProjectWriter::generateSection(HelpProject &project, QXmlStreamWriter &
         project.m_keywords.append(keywordDetails(node));
         {
             const auto *enumNode = static_cast<const EnumNode *>(node);
+            const QString &ref = documentLocation(node);
             const auto items = enumNode->items();
             for (const auto &item : items) {
                 if (enumNode->itemAccess(item.name()) == Access::Private)
@@ -302,7 +332,6 @@ bool HelpProjectWriter::generateSection(HelpProject &project, QXmlStreamWriter &
                 } else {
                     name = id = item.name();
                 }
-                QString ref = m_gen->fullDocumentLocation(node);
                 project.m_keywords.append(Keyword(name, id, ref));
             }
         }
@@ -357,7 +386,7 @@ bool HelpProjectWriter::generateSection(HelpProject &project, QXmlStreamWriter &
         // Use the location of any associated enum node in preference
         // to that of the typedef.
         if (enumNode)
-            typedefDetails.m_ref = m_gen->fullDocumentLocation(enumNode);
+            typedefDetails.m_ref = documentLocation(enumNode);
 
         project.m_keywords.append(typedefDetails);
     } break;
@@ -409,6 +438,13 @@ void HelpProjectWriter::generateSections(HelpProject &project, QXmlStreamWriter
 
         // Ensure that we don't visit nodes more than once.
         NodeList childSet;
+        QSet<const Node *> visited;
+        auto addChild = [&](Node *child) {
+            if (!visited.contains(child)) {
+                visited.insert(child);
+                childSet << child;
+            }
+        };
         NodeList children = aggregate->childNodes();
         std::sort(children.begin(), children.end(), Node::nodeNameLessThan);
         for (auto *child : children) {
@@ -417,21 +453,20 @@ void HelpProjectWriter::generateSections(HelpProject &project, QXmlStreamWriter
                 continue;
             // Process unseen group nodes (even though they're marked internal)
             if (child->isGroup() && !child->wasSeen()) {
+                visited.insert(child);
                 childSet << child;
                 continue;
             }
             if (child->isIndexNode() || child->isPrivate())
                 continue;
             if (child->isTextPageNode()) {
-                if (!childSet.contains(child))
-                    childSet << child;
+                addChild(child);
             } else {
                 // Store member status of children
                 project.m_memberStatus[node].insert(child->status());
                 if (child->isFunction() && static_cast<const FunctionNode *>(child)->isOverload())
                     continue;
-                if (!childSet.contains(child))
-                    childSet << child;
+                addChild(child);
             }
         }
         for (const auto *child : std::as_const(childSet))
@@ -450,13 +485,30 @@ void HelpProjectWriter::generate()
         generateProject(project);
 }
 
-void HelpProjectWriter::writeSection(QXmlStreamWriter &writer, const QString &path,
-                                     const QString &value)
+void HelpProjectWriter::writeSection(HelpProject &project, QXmlStreamWriter &writer,
+                                     const QString &path, const QString &value)
+{
+    startSection(project, writer, path, value);
+    endSection(writer);
+}
+
+/*!
+    Starts a section of the table of contents, and records it in the
+    table of contents of \a project for writing a .qch file.
+ */
+void HelpProjectWriter::startSection(HelpProject &project, QXmlStreamWriter &writer,
+                                     const QString &path, const QString &value)
 {
     writer.writeStartElement(QStringLiteral("section"));
     writer.writeAttribute(QStringLiteral("ref"), path);
     writer.writeAttribute(QStringLiteral("title"), value);
+    project.m_tableOfContents.append({ m_sectionDepth++, path, value });
+}
+
+void HelpProjectWriter::endSection(QXmlStreamWriter &writer)
+{
     writer.writeEndElement(); // section
+    --m_sectionDepth;
 }
 
 /*!
@@ -464,8 +516,8 @@ void HelpProjectWriter::writeSection(QXmlStreamWriter &writer, const QString &pa
  */
 void HelpProjectWriter::addMembers(HelpProject &project, QXmlStreamWriter &writer, const Node *node)
 {
-    QString href = m_gen->fullDocumentLocation(node);
-    href = href.left(href.size() - 5);
+    const QString &location = documentLocation(node);
+    const QString href = location.left(location.size() - 5);
     if (href.isEmpty())
         return;
 
@@ -475,20 +527,21 @@ void HelpProjectWriter::addMembers(HelpProject &project, QXmlStreamWriter &write
 
     // Do not generate a 'List of all members' for namespaces or header files,
     // but always generate it for derived classes and QML types (but not QML value types)
+    const HelpProject::NodeStatusSet memberStatus = project.m_memberStatus.value(node);
     if (!node->isNamespace() && !node->isHeader() && !node->isQmlBasicType()
-        && (derivedClass || node->isQmlType() || !project.m_memberStatus[node].isEmpty())) {
+        && (derivedClass || node->isQmlType() || !memberStatus.isEmpty())) {
         QString membersPath = href + QStringLiteral("-members.html");
-        writeSection(writer, membersPath, QStringLiteral("List of all members"));
+        writeSection(project, writer, membersPath, QStringLiteral("List of all members"));
     }
-    if (project.m_memberStatus[node].contains(Node::Deprecated)) {
+    if (memberStatus.contains(Node::Deprecated)) {
         QString obsoletePath = href + QStringLiteral("-obsolete.html");
-        writeSection(writer, obsoletePath, QStringLiteral("Obsolete members"));
+        writeSection(project, writer, obsoletePath, QStringLiteral("Obsolete members"));
     }
 }
 
 void HelpProjectWriter::writeNode(HelpProject &project, QXmlStreamWriter &writer, const Node *node)
 {
-    QString href = m_gen->fullDocumentLocation(node);
+    const QString &href = documentLocation(node);
     QString objName = node->name();
 
     switch (node->nodeType()) {
@@ -501,21 +554,17 @@ void HelpProjectWriter::writeNode(HelpProject &project, QXmlStreamWriter &writer
         QString typeStr = m_gen->typeString(node);
         if (!typeStr.isEmpty())
             typeStr[0] = typeStr[0].toTitleCase();
-        writer.writeStartElement("section");
-        writer.writeAttribute("ref", href);
-        if (node->parent() && !node->parent()->name().isEmpty())
-            writer.writeAttribute("title",
-                                  QStringLiteral("%1::%2 %3 Reference")
-                                          .arg(node->parent()->name(), objName, typeStr));
-        else
-            writer.writeAttribute("title", QStringLiteral("%1 %2 Reference").arg(objName, typeStr));
-
+        const QString title = (node->parent() && !node->parent()->name().isEmpty())
+                ? QStringLiteral("%1::%2 %3 Reference")
+                          .arg(node->parent()->name(), objName, typeStr)
+                : QStringLiteral("%1 %2 Reference").arg(objName, typeStr);
+        startSection(project, writer, href, title);
         addMembers(project, writer, node);
-        writer.writeEndElement(); // section
+        endSection(writer);
     } break;
 
     case Node::Namespace:
-        writeSection(writer, href, "%1 Namespace Reference"_L1.arg(objName));
+        writeSection(project, writer, href, "%1 Namespace Reference"_L1.arg(objName));
         break;
 
     case Node::Example:
@@ -524,12 +573,10 @@ void HelpProjectWriter::writeNode(HelpProject &project, QXmlStreamWriter &writer
     case Node::Group:
     case Node::Module:
     case Node::QmlModule: {
-        writer.writeStartElement("section");
-        writer.writeAttribute("ref", href);
-        writer.writeAttribute("title", node->fullTitle());
+        startSection(project, writer, href, node->fullTitle());
         if (node->nodeType() == Node::HeaderFile)
             addMembers(project, writer, node);
-        writer.writeEndElement(); // section
+        endSection(writer);
     } break;
     default:;
     }
@@ -553,8 +600,15 @@ void HelpProjectWriter::generateProject(HelpProject &project)
 
     project.m_files.clear();
     project.m_keywords.clear();
-
-    QFile file(m_outputDir + QDir::separator() + project.m_fileName);
+    project.m_tableOfContents.clear();
+    m_documentLocations.clear();
+    m_sectionDepth = 0;
+
+    // The table of contents and the keywords are collected while the
+    // .qhp file is written; if only a .qch file is wanted, the XML is
+    // discarded.
+    QFile file(project.m_writeQhp ? m_outputDir + QDir::separator() + project.m_fileName
+                                  : QProcess::nullDevice());
     if (!file.open(QFile::WriteOnly))
         return;
 
@@ -594,7 +648,6 @@ void HelpProjectWriter::generateProject(HelpProject &project)
         writer.writeTextElement("filterAttribute", filterName);
 
     writer.writeStartElement("toc");
-    writer.writeStartElement("section");
     const Node *node = m_qdb->findPageNodeByTitle(project.m_indexTitle);
     if (!node)
         node = m_qdb->findNodeByNameAndType(QStringList(project.m_indexTitle), &Node::isPageNode);
@@ -605,13 +658,11 @@ void HelpProjectWriter::generateProject(HelpProject &project)
         indexPath = m_gen->fullDocumentLocation(node);
     else
         indexPath = "index.html";
-    writer.writeAttribute("ref", indexPath);
-    writer.writeAttribute("title", project.m_indexTitle);
+    startSection(project, writer, indexPath, project.m_indexTitle);
 
     generateSections(project, writer, rootNode);
 
-    for (int i = 0; i < project.m_subprojects.size(); i++) {
-        SubProject subproject = project.m_subprojects[i];
+    for (const SubProject &subproject : std::as_const(project.m_subprojects)) {
 
         if (subproject.m_type == QLatin1String("manual")) {
 
@@ -629,7 +680,7 @@ void HelpProjectWriter::generateProject(HelpProject &project)
                         break;
                     case Atom::ListRight:
                         if (sectionStack.pop() > 0)
-                            writer.writeEndElement(); // section
+                            endSection(writer);
                         break;
                     case Atom::ListItemLeft:
                         inItem = true;
@@ -640,13 +691,11 @@ void HelpProjectWriter::generateProject(HelpProject &project)
                     case Atom::Link:
                         if (inItem) {
                             if (sectionStack.top() > 0)
-                                writer.writeEndElement(); // section
+                                endSection(writer);
 
                             const Node *page = m_qdb->findNodeForTarget(atom->string(), nullptr);
-                            writer.writeStartElement("section");
-                            QString indexPath = m_gen->fullDocumentLocation(page);
-                            writer.writeAttribute("ref", indexPath);
-                            writer.writeAttribute("title", atom->linkText());
+                            startSection(project, writer, m_gen->fullDocumentLocation(page),
+                                         atom->linkText());
 
                             sectionStack.top() += 1;
                         }
@@ -664,20 +713,18 @@ void HelpProjectWriter::generateProject(HelpProject &project)
 
         } else {
 
-            writer.writeStartElement("section");
             QString indexPath = m_gen->fullDocumentLocation(
                     m_qdb->findNodeForTarget(subproject.m_indexTitle, nullptr));
             if (indexPath.isEmpty() && !subproject.m_indexTitle.isEmpty())
                 Config::instance().location().warning(
                         "Failed to find %1.indexTitle '%2'"_L1.arg(subproject.m_prefix, subproject.m_indexTitle));
-            writer.writeAttribute("ref", indexPath);
-            writer.writeAttribute("title", subproject.m_title);
+            startSection(project, writer, indexPath, subproject.m_title);
 
             if (subproject.m_sortPages) {
                 QStringList titles = subproject.m_nodes.keys();
                 titles.sort();
                 for (const auto &title : std::as_const(titles)) {
-                    writeNode(project, writer, subproject.m_nodes[title]);
+                    writeNode(project, writer, subproject.m_nodes.value(title));
                 }
             } else {
                 // Find a contents node and navigate from there, using the NextLink values.
@@ -716,14 +763,14 @@ void HelpProjectWriter::generateProject(HelpProject &project)
                 }
             }
 
-            writer.writeEndElement(); // section
+            endSection(writer);
         }
     }
 
     // Restore original search order
     m_qdb->setSearchOrder(searchOrder);
 
-    writer.writeEndElement(); // section
+    endSection(writer);
     writer.writeEndElement(); // toc
 
     writer.writeStartElement("keywords");
@@ -747,18 +794,37 @@ void HelpProjectWriter::generateProject(HelpProject &project)
             QSet<QString>(m_gen->outputFileNames().cbegin(), m_gen->outputFileNames().cend());
     files.unite(project.m_files);
     files.unite(project.m_extraFiles);
+    files.remove(QString());
     QStringList sortedFiles = files.values();
     sortedFiles.sort();
-    for (const auto &usedFile : std::as_const(sortedFiles)) {
-        if (!usedFile.isEmpty())
-            writer.writeTextElement("file", usedFile);
-    }
+    for (const auto &usedFile : std::as_const(sortedFiles))
+        writer.writeTextElement("file", usedFile);
     writer.writeEndElement(); // files
 
     writer.writeEndElement(); // filterSection
     writer.writeEndElement(); // QtHelpProject
     writer.writeEndDocument();
     file.close();
+
+    if (!project.m_qchFileName.isEmpty())
+        writeQch(project, sortedFiles);
+}
+
+/*!
+    Writes the Qt compressed help file of \a project, with the contents
+    of \a files, directly; this spares running qhelpgenerator on the
+    .qhp file.
+ */
+void HelpProjectWriter::writeQch(const HelpProject &project, const QStringList &files)
+{
+#ifndef QDOC_NO_QCH
+    QchWriter qchWriter(m_outputDir, m_outputDir + QDir::separator() + project.m_qchFileName);
+    if (!qchWriter.write(project, files))
+        Config::instance().location().warning(qchWriter.errorString());
+#else
+    Q_UNUSED(project);
+    Q_UNUSED(files);
+#endif
 }
 
 QT_END_NAMESPACE
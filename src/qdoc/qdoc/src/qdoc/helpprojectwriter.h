@@ -54,6 +54,16 @@ struct Keyword {
     }
 };
 
+/*
+ * An entry in the table of contents of a help project, in document
+ * order. Depth is the nesting level of the section, starting from 0.
+ */
+struct TocEntry {
+    int m_depth {};
+    QString m_ref {};
+    QString m_title {};
+};
+
 struct HelpProject
 {
     using NodeStatusSet = QSet<unsigned char>;
@@ -63,9 +73,12 @@ struct HelpProject
     QString m_virtualFolder {};
     QString m_version {};
     QString m_fileName {};
+    QString m_qchFileName {};
+    bool m_writeQhp { true };
     QString m_indexRoot {};
     QString m_indexTitle {};
     QList<Keyword> m_keywords {};
+    QList<TocEntry> m_tableOfContents {};
     QSet<QString> m_files {};
     QSet<QString> m_extraFiles {};
     QSet<QString> m_filterAttributes {};
@@ -89,17 +102,25 @@ private:
     void generateProject(HelpProject &project);
     void generateSections(HelpProject &project, QXmlStreamWriter &writer, const Node *node);
     bool generateSection(HelpProject &project, QXmlStreamWriter &writer, const Node *node);
-    Keyword keywordDetails(const Node *node) const;
+    Keyword keywordDetails(const Node *node);
+    const QString &documentLocation(const Node *node);
     void writeNode(HelpProject &project, QXmlStreamWriter &writer, const Node *node);
     void readSelectors(SubProject &subproject, const QStringList &selectors);
     void addMembers(HelpProject &project, QXmlStreamWriter &writer, const Node *node);
-    void writeSection(QXmlStreamWriter &writer, const QString &path, const QString &value);
+    void writeSection(HelpProject &project, QXmlStreamWriter &writer, const QString &path,
+                      const QString &value);
+    void startSection(HelpProject &project, QXmlStreamWriter &writer, const QString &path,
+                      const QString &value);
+    void endSection(QXmlStreamWriter &writer);
+    void writeQch(const HelpProject &project, const QStringList &files);
 
     QDocDatabase *m_qdb {};
     Generator *m_gen {};
 
     QString m_outputDir {};
     QList<HelpProject> m_projects {};
+    QHash<const Node *, QString> m_documentLocations {};
+    int m_sectionDepth {};
 };
 
 QT_END_NAMESPACE
@@ -716,8 +716,9 @@ qsizetype HtmlGenerator::generateAtom(const Atom *atom, const Node *relative, Co
         if (link.isEmpty() && (node != relative) && !noLinkErrors()) {
             Location location = atom->isLinkAtom() ? static_cast<const LinkAtom*>(atom)->location
                                                    : relative->doc().location();
-            location.warning(
-                    QStringLiteral("Can't link to '%1'").arg(atom->string()));
+            if (m_qdb->isFirstUnresolvedLink(atom, relative, location))
+                location.warning(
+                        QStringLiteral("Can't link to '%1'").arg(atom->string()));
         }
         beginLink(link, node, relative);
         skipAhead = 1;
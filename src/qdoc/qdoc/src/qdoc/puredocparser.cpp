@@ -27,31 +27,210 @@ std::vector<UntiedDocumentation> PureDocParser::parse_qdoc_file(const QString &f
     return processQdocComments(in);
 }
 
+namespace {
+
+/*
+  Finds the qdoc comments in the contents of a .qdoc file. Unlike the
+  Tokenizer, it doesn't lex the text between the comments, which must
+  be free of preprocessor directives and literals, but jumps from
+  one comment opener to the next. Locations are computed only at the
+  boundaries of the comments, but otherwise match the ones that the
+  Tokenizer reports: the start of a qdoc comment, and the start of the
+  token that follows it.
+ */
+class QdocCommentScanner
+{
+public:
+    QdocCommentScanner(const QString &filePath, QByteArray source)
+        : m_source(std::move(source)), m_location(filePath)
+    {
+        m_location.start();
+    }
+
+    bool next();
+
+    [[nodiscard]] QByteArrayView comment() const { return m_comment; }
+    [[nodiscard]] const Location &startLocation() const { return m_startLocation; }
+    [[nodiscard]] const Location &endLocation() const { return m_endLocation; }
+
+private:
+    qsizetype skipComment(qsizetype offset);
+    qsizetype skipToToken(qsizetype offset);
+    const Location &locationAt(qsizetype offset);
+
+    QByteArray m_source;
+    qsizetype m_pos { 0 };
+    QByteArrayView m_comment {};
+    Location m_startLocation {};
+    Location m_endLocation {};
+    Location m_location;
+    qsizetype m_locationOffset { 0 };
+};
+
+bool isSpace(char c)
+{
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+/*
+  Finds the next qdoc comment. Returns \c false if there are none left.
+ */
+bool QdocCommentScanner::next()
+{
+    const QByteArrayView source(m_source);
+    while (m_pos < source.size()) {
+        const qsizetype slash = source.indexOf('/', m_pos);
+        if (slash < 0 || slash + 1 == source.size())
+            break;
+
+        const char c = source[slash + 1];
+        if (c == '/') {
+            const qsizetype newline = source.indexOf('\n', slash + 2);
+            m_pos = newline < 0 ? source.size() : newline;
+        } else if (c == '*') {
+            const qsizetype end = skipComment(slash);
+            if (slash + 2 < source.size() && source[slash + 2] == '!') {
+                m_comment = source.sliced(slash, end - slash);
+                m_startLocation = locationAt(slash);
+                m_endLocation = locationAt(skipToToken(end));
+                return true;
+            }
+            m_pos = end;
+        } else {
+            m_pos = slash + 1;
+        }
+    }
+    m_pos = source.size();
+    return false;
+}
+
+/*
+  Returns the offset just past the C-style comment that starts at
+  \a offset, or the end of the source if the comment is unterminated.
+ */
+qsizetype QdocCommentScanner::skipComment(qsizetype offset)
+{
+    const qsizetype end = QByteArrayView(m_source).indexOf("*/", offset + 2);
+    if (end >= 0)
+        return end + 2;
+
+    locationAt(offset).warning(QStringLiteral("Unterminated C++ comment"));
+    return m_source.size();
+}
+
+/*
+  Skips whitespace and comments other than qdoc comments from
+  \a offset, and returns the offset of the token that follows them. At
+  the end of the source, it returns the offset of the last item that
+  was skipped, as that is where the Tokenizer reports the end of input.
+  Scanning resumes after the skipped text.
+ */
+qsizetype QdocCommentScanner::skipToToken(qsizetype offset)
+{
+    const QByteArrayView source(m_source);
+    while (offset < source.size()) {
+        qsizetype pos = offset;
+        if (isSpace(source[pos])) {
+            while (pos < source.size() && isSpace(source[pos]))
+                ++pos;
+        } else if (source.sliced(pos).startsWith("//")) {
+            pos = source.indexOf('\n', pos + 2);
+            if (pos < 0)
+                pos = source.size();
+        } else if (source.sliced(pos).startsWith("/*") && !source.sliced(pos).startsWith("/*!")) {
+            pos = skipComment(pos);
+        } else {
+            break;
+        }
+
+        if (pos == source.size()) {
+            m_pos = pos;
+            return offset;
+        }
+        offset = pos;
+    }
+    m_pos = offset;
+    return offset;
+}
+
+/*
+  Returns the location of \a offset, which must not precede the offset
+  of the previous call. Lines are counted in the stretch between the
+  two offsets, and only the last line is walked through character by
+  character, so that columns are advanced the way the Tokenizer does.
+ */
+const Location &QdocCommentScanner::locationAt(qsizetype offset)
+{
+    Q_ASSERT(offset >= m_locationOffset);
+    const QByteArrayView stretch = QByteArrayView(m_source).sliced(m_locationOffset,
+                                                                   offset - m_locationOffset);
+    const qsizetype lines = stretch.count('\n');
+    qsizetype lineStart = 0;
+    if (lines > 0) {
+        m_location.setLineNo(m_location.lineNo() + int(lines));
+        m_location.setColumnNo(1);
+        lineStart = stretch.lastIndexOf('\n') + 1;
+    }
+    for (char c : stretch.sliced(lineStart))
+        m_location.advance(QLatin1Char(c));
+    m_locationOffset = offset;
+    return m_location;
+}
+
+} // namespace
+
+/*
+  Returns \c true if the text outside the comments in \a source contains
+  anything that the Tokenizer interprets rather than skips: preprocessor
+  directives, which are evaluated against the \c defines and
+  \c falsehoods, and string or character literals, which can hide
+  comment openers.
+ */
+static bool hasCodeOutsideComments(QByteArrayView source)
+{
+    qsizetype pos = 0;
+    while (pos < source.size()) {
+        const char c = source[pos];
+        if (c == '#' || c == '"' || c == '\'')
+            return true;
+        if (c == '/' && pos + 1 < source.size()) {
+            if (source[pos + 1] == '/') {
+                pos = source.indexOf('\n', pos + 2);
+                if (pos < 0)
+                    return false;
+                continue;
+            }
+            if (source[pos + 1] == '*') {
+                const qsizetype end = source.indexOf("*/", pos + 2);
+                if (end < 0)
+                    return false;
+                pos = end + 2;
+                continue;
+            }
+        }
+        ++pos;
+    }
+    return false;
+}
+
 /*!
   This is called by parseSourceFile() to do the actual parsing
   and tree building. It only processes qdoc comments. It skips
   everything else.
+
+  Most .qdoc files contain nothing but comments and whitespace, and
+  are searched for qdoc comments without being tokenized. Files with
+  preprocessor directives or literals between the comments are run
+  through the Tokenizer, so that conditionals are honored.
  */
 std::vector<UntiedDocumentation> PureDocParser::processQdocComments(QFile& input_file)
 {
     std::vector<UntiedDocumentation> untied{};
 
-    Tokenizer tokenizer(Location{input_file.fileName()}, input_file);
-
     const QSet<QString> &commands = CppCodeParser::topic_commands + CppCodeParser::meta_commands;
 
-    int token = tokenizer.getToken();
-    while (token != Tok_Eoi) {
-        if (token != Tok_Doc) {
-            token = tokenizer.getToken();
-            continue;
-        }
-        QString comment = tokenizer.lexeme(); // returns an entire qdoc comment.
-        Location start_loc(tokenizer.location());
-        token = tokenizer.getToken();
-
+    auto addDocumentation = [&](QString comment, Location start_loc, const Location &end_loc) {
         Doc::trimCStyleComment(start_loc, comment);
-        Location end_loc(tokenizer.location());
 
         // Doc constructor parses the comment.
         Doc doc(start_loc, end_loc, comment, commands, CppCodeParser::topic_commands);
@@ -59,13 +238,36 @@ std::vector<UntiedDocumentation> PureDocParser::processQdocComments(QFile& input
             doc.location().warning(QStringLiteral("This qdoc comment contains no topic command "
                                                   "(e.g., '\\%1', '\\%2').")
                                            .arg(COMMAND_MODULE, COMMAND_PAGE));
-            continue;
+            return;
         }
 
         if (hasTooManyTopics(doc))
-            continue;
+            return;
 
         untied.emplace_back(UntiedDocumentation{doc, QStringList()});
+    };
+
+    QByteArray source = input_file.readAll();
+    if (hasCodeOutsideComments(source)) {
+        Tokenizer tokenizer(Location{input_file.fileName()}, std::move(source));
+        int token = tokenizer.getToken();
+        while (token != Tok_Eoi) {
+            if (token != Tok_Doc) {
+                token = tokenizer.getToken();
+                continue;
+            }
+            QString comment = tokenizer.lexeme(); // an entire qdoc comment.
+            Location start_loc(tokenizer.location());
+            token = tokenizer.getToken();
+            addDocumentation(comment, start_loc, tokenizer.location());
+        }
+        return untied;
+    }
+
+    QdocCommentScanner scanner(input_file.fileName(), std::move(source));
+    while (scanner.next()) {
+        addDocumentation(Tokenizer::decodeSource(scanner.comment()), scanner.startLocation(),
+                         scanner.endLocation());
     }
 
     return untied;
@@ -0,0 +1,191 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "qchwriter.h"
+
+#include "config.h"
+#include "helpprojectwriter.h"
+
+#include <qchtablewriter.h>
+
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qregularexpression.h>
+#include <QtSql/qsqldatabase.h>
+#include <QtSql/qsqlerror.h>
+#include <QtSql/qsqlquery.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+/*!
+  \class QchWriter
+  \internal
+  \brief The QchWriter class writes the Qt compressed help file of a
+  help project.
+
+  The file has the same contents as the one qhelpgenerator creates from
+  the .qhp file that HelpProjectWriter writes for the project: both
+  fill the tables with QchTableWriter, from the same data. Writing the
+  file directly saves parsing the help project again, and a separate
+  run over the output.
+*/
+
+static const auto connectionName = "qdoc-qch"_L1;
+
+/*
+  Returns the files that \a pattern, a path relative to \a rootPath,
+  stands for, the way qhelpgenerator expands the file names of a help
+  project: wildcards match the files in the directory of the pattern.
+  A pattern without wildcards, or one that matches no file, is returned
+  as is. The entries of the directories read are cached in
+  \a dirEntries.
+*/
+static QStringList matchingFiles(const QString &pattern, const QString &rootPath,
+                                 QHash<QString, QStringList> &dirEntries)
+{
+    if (!pattern.contains(u'?') && !pattern.contains(u'*') && !pattern.contains(u'[')
+        && !pattern.contains(u']')) {
+        return { pattern };
+    }
+
+    const QFileInfo fileInfo(rootPath + QLatin1Char('/') + pattern);
+    const QDir dir = fileInfo.dir();
+    const QString path = dir.canonicalPath();
+    auto it = dirEntries.constFind(path);
+    if (it == dirEntries.cend())
+        it = dirEntries.insert(path, dir.entryList(QDir::Files));
+
+#ifdef Q_OS_WIN
+    const auto options = QRegularExpression::CaseInsensitiveOption;
+#else
+    const auto options = QRegularExpression::NoPatternOption;
+#endif
+    const QRegularExpression regExp(
+            QRegularExpression::wildcardToRegularExpression(fileInfo.fileName()), options);
+    const QString patternDir = QFileInfo(pattern).dir().path();
+    QStringList files;
+    for (const QString &entry : it.value()) {
+        if (regExp.match(entry).hasMatch())
+            files.append(patternDir + QLatin1Char('/') + entry);
+    }
+    if (files.isEmpty())
+        files.append(pattern);
+    return files;
+}
+
+/*!
+  Constructs a writer for the file \a fileName. The files of the help
+  project are read relative to \a rootPath, the directory of the .qhp
+  file.
+*/
+QchWriter::QchWriter(QString rootPath, QString fileName)
+    : m_rootPath(std::move(rootPath)), m_fileName(std::move(fileName))
+{
+}
+
+/*!
+  Writes the help \a project, the table of contents and keywords of
+  which have been generated, with the contents of \a files. An existing
+  file is replaced. Returns \c false and sets the error string if the
+  file cannot be written.
+*/
+bool QchWriter::write(const HelpProject &project, const QStringList &files)
+{
+    m_error.clear();
+
+    if (project.m_helpNamespace.isEmpty() || project.m_virtualFolder.isEmpty()) {
+        m_error = u"The help project does not define a namespace and a virtual folder"_s;
+        return false;
+    }
+    if (QFileInfo::exists(m_fileName) && !QFile::remove(m_fileName)) {
+        m_error = u"The file %1 cannot be overwritten"_s.arg(m_fileName);
+        return false;
+    }
+
+    bool ok = false;
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase(u"QSQLITE"_s, connectionName);
+        db.setDatabaseName(m_fileName);
+        if (db.open()) {
+            QSqlQuery query(db);
+            ok = writeTables(query, project, files);
+        } else {
+            m_error = u"Cannot open database file %1: %2"_s.arg(m_fileName,
+                                                              db.lastError().text());
+        }
+        db.close();
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+    return ok;
+}
+
+/*
+  Fills the tables the way qhelpgenerator does for the .qhp file of
+  \a project: the project has a single filter section, and keywords
+  that the .qhp reader rejects are left out.
+*/
+bool QchWriter::writeTables(QSqlQuery &query, const HelpProject &project,
+                            const QStringList &files)
+{
+    query.exec(u"PRAGMA synchronous=OFF"_s);
+    query.exec(u"PRAGMA cache_size=3000"_s);
+
+    const QString qchFileName = QFileInfo(m_fileName).fileName();
+    QchTableWriter tables(&query, [&qchFileName](const QString &message) {
+        Config::instance().location().warning(u"%1: %2"_s.arg(qchFileName, message));
+    });
+    const auto fail = [this, &query, &tables]() {
+        const QString reason = tables.error().isEmpty() ? query.lastError().text() : tables.error();
+        m_error = u"Cannot write %1: %2"_s.arg(m_fileName, reason);
+        return false;
+    };
+
+    if (!tables.createTables() || !tables.insertFileNotFoundFile())
+        return fail();
+    tables.insertMetaData({ { u"version"_s, project.m_version } });
+    if (!tables.registerVirtualFolder(project.m_virtualFolder, project.m_helpNamespace))
+        return fail();
+
+    for (auto it = project.m_customFilters.cbegin(); it != project.m_customFilters.cend(); ++it) {
+        QStringList attributes = it.value().values();
+        attributes.sort();
+        if (!tables.registerCustomFilter(it.key(), attributes))
+            return fail();
+    }
+
+    QStringList filterAttributes = project.m_filterAttributes.values();
+    filterAttributes.sort();
+    tables.insertFilterAttributes(filterAttributes);
+
+    QStringList expandedFiles;
+    QHash<QString, QStringList> dirEntries;
+    for (const QString &file : files)
+        expandedFiles += matchingFiles(file, m_rootPath, dirEntries);
+    if (!tables.insertFiles(expandedFiles, m_rootPath, filterAttributes))
+        return fail();
+
+    QList<QchTableWriter::ContentsEntry> contents;
+    contents.reserve(project.m_tableOfContents.size());
+    for (const TocEntry &entry : project.m_tableOfContents)
+        contents.append({ entry.m_depth, entry.m_ref, entry.m_title });
+    if (!tables.insertContents(contents, filterAttributes))
+        return fail();
+
+    QList<QchTableWriter::Keyword> keywords;
+    for (const Keyword &keyword : project.m_keywords) {
+        for (const QString &id : keyword.m_ids) {
+            if (keyword.m_ref.isEmpty() || (keyword.m_name.isEmpty() && id.isEmpty()))
+                continue;
+            keywords.append({ keyword.m_name, id, keyword.m_ref });
+        }
+    }
+    if (!tables.insertKeywords(keywords, filterAttributes))
+        return fail();
+    return true;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,33 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef QCHWRITER_H
+#define QCHWRITER_H
+
+#include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
+
+QT_BEGIN_NAMESPACE
+
+struct HelpProject;
+class QSqlQuery;
+
+class QchWriter
+{
+public:
+    QchWriter(QString rootPath, QString fileName);
+
+    bool write(const HelpProject &project, const QStringList &files);
+    [[nodiscard]] const QString &errorString() const { return m_error; }
+
+private:
+    bool writeTables(QSqlQuery &query, const HelpProject &project, const QStringList &files);
+
+    QString m_rootPath {};
+    QString m_fileName {};
+    QString m_error {};
+};
+
+QT_END_NAMESPACE
+
+#endif // QCHWRITER_H
@@ -253,6 +253,80 @@ void QDocForest::newPrimaryTree(const QString &module)
     m_primaryTree = new Tree(module, m_qdb);
 }
 
+/*!
+  Returns the QML type node registered under the qualified
+  \a name, which is a QML module identifier (possibly with a
+  version) and a type name joined with \c{::}, in the first
+  tree of the search order that has one. Returns \c nullptr
+  if there is no such type.
+ */
+QmlTypeNode *QDocForest::lookupQmlType(const QString &name)
+{
+    if (!updateQmlTypeIndex()) {
+        for (const auto *tree : searchOrder()) {
+            if (auto *qcn = tree->lookupQmlType(name); qcn)
+                return qcn;
+        }
+        return nullptr;
+    }
+
+    if (auto *qcn = m_searchOrder.constFirst()->lookupQmlType(name); qcn)
+        return qcn;
+    return m_qmlTypesByKey.value(name);
+}
+
+/*!
+  Returns the first QML type node named \a name that is a child
+  of a tree root, searching the trees in search order, or
+  \c nullptr if there is no such type.
+ */
+QmlTypeNode *QDocForest::findQmlTypeByName(const QString &name)
+{
+    const QStringList path(name);
+    if (!updateQmlTypeIndex())
+        return static_cast<QmlTypeNode *>(findNodeByNameAndType(path, &Node::isQmlType));
+
+    if (auto *node = m_searchOrder.constFirst()->findNodeByNameAndType(path, &Node::isQmlType); node)
+        return static_cast<QmlTypeNode *>(node);
+    return m_qmlTypesByName.value(name);
+}
+
+/*!
+  Makes sure the forest-wide QML type index reflects the current
+  search order. The index covers all trees in the search order
+  except the first one, the primary tree, which can still change
+  while its sources are parsed and is therefore searched directly.
+  The other trees are read from index files and do not change, so
+  the index is only rebuilt when the search order changes.
+
+  Returns \c false if the search order is not known yet, in which
+  case the trees must be searched one by one.
+ */
+bool QDocForest::updateQmlTypeIndex()
+{
+    if (m_searchOrder.isEmpty())
+        return false;
+    if (m_qmlTypeIndexTrees == m_searchOrder)
+        return true;
+
+    m_qmlTypesByKey.clear();
+    m_qmlTypesByName.clear();
+    for (auto it = std::next(m_searchOrder.cbegin()); it != m_searchOrder.cend(); ++it) {
+        const Tree *tree = *it;
+        const QmlTypeMap &types = tree->qmlTypeMap();
+        for (auto type = types.cbegin(); type != types.cend(); ++type) {
+            if (!m_qmlTypesByKey.contains(type.key()))
+                m_qmlTypesByKey.insert(type.key(), type.value());
+        }
+        for (auto *node : tree->root()->childNodes()) {
+            if (node && node->isQmlType() && !m_qmlTypesByName.contains(node->name()))
+                m_qmlTypesByName.insert(node->name(), static_cast<QmlTypeNode *>(node));
+        }
+    }
+    m_qmlTypeIndexTrees = m_searchOrder;
+    return true;
+}
+
 /*!
   Searches through the forest for a node named \a targetPath
   and returns a pointer to it if found. The \a relative node
@@ -641,8 +715,7 @@ QmlTypeNode *QDocDatabase::findQmlType(const QString &qmid, const QString &name)
             return qcn;
     }
 
-    QStringList path(name);
-    return static_cast<QmlTypeNode *>(m_forest.findNodeByNameAndType(path, &Node::isQmlType));
+    return m_forest.findQmlTypeByName(name);
 }
 
 /*!
@@ -892,6 +965,8 @@ const NodeMultiMap &QDocDatabase::getSinceMap(const QString &key)
  */
 void QDocDatabase::resolveStuff()
 {
+    clearLinkCache();
+
     const auto &config = Config::instance();
     if (config.dualExec() || config.preparing()) {
         // order matters
@@ -923,6 +998,10 @@ void QDocDatabase::resolveStuff()
     }
     if (config.dualExec())
         QDocIndexFiles::destroyQDocIndexFiles();
+
+    // The forest and the search order do not change from here on, so
+    // link resolutions can be shared by all generators.
+    m_cacheLinks = true;
 }
 
 void QDocDatabase::resolveBaseClasses()
@@ -1416,9 +1495,84 @@ void QDocDatabase::mergeCollections(CollectionNode *c)
   in the path after the node is found. The node is returned as
   well as the \a ref. If the returned node pointer is null,
   \a ref is also not valid.
+
+  During generation, the outcome of each search, including a failed
+  one, is cached for the link target, domain, genus, and \a relative
+  node, so that each link is resolved once even if several output
+  formats are generated.
  */
-const Node *QDocDatabase::findNodeForAtom(const Atom *a, const Node *relative, QString &ref,
+const Node *QDocDatabase::findNodeForAtom(const Atom *atom, const Node *relative, QString &ref,
                                           Node::Genus genus)
+{
+    if (!m_cacheLinks || !ref.isEmpty())
+        return resolveLinkTarget(atom, relative, ref, genus);
+
+    const LinkKey key = linkKey(atom, relative, genus);
+    auto it = m_resolvedLinks.constFind(key);
+    if (it == m_resolvedLinks.constEnd()) {
+        const Node *node = resolveLinkTarget(atom, relative, ref, genus);
+        it = m_resolvedLinks.insert(key, { node, ref });
+    }
+    ref = it->m_ref;
+    return it->m_node;
+}
+
+/*!
+  Returns \c true if a link to the target of \a atom from \a relative
+  at \a location that could not be resolved has not been reported yet
+  during generation, and records it as reported. Generators use this
+  to warn about each unresolved link once, rather than once per output
+  format. Each occurrence of the link is still reported.
+ */
+bool QDocDatabase::isFirstUnresolvedLink(const Atom *atom, const Node *relative,
+                                         const Location &location)
+{
+    if (!m_cacheLinks)
+        return true;
+
+    const qsizetype size = m_reportedUnresolvedLinks.size();
+    m_reportedUnresolvedLinks.insert(
+            { linkKey(atom, relative, Node::DontCare), location.toString() });
+    return m_reportedUnresolvedLinks.size() != size;
+}
+
+/*!
+  \internal
+
+  Returns the key under which the outcome of resolving the link in
+  \a atom from \a relative with \a genus is cached. For link atoms,
+  the domain and genus given in square brackets take precedence.
+ */
+QDocDatabase::LinkKey QDocDatabase::linkKey(const Atom *atom, const Node *relative,
+                                            Node::Genus genus)
+{
+    auto *a = const_cast<Atom *>(atom);
+    if (a->isLinkAtom())
+        return { a->string(), relative, a->domain(), a->genus() };
+    return { a->string(), relative, nullptr, genus };
+}
+
+/*!
+  \internal
+
+  Clears the cached link resolutions and the record of reported
+  unresolved links, and disables caching until resolveStuff()
+  completes.
+ */
+void QDocDatabase::clearLinkCache()
+{
+    m_cacheLinks = false;
+    m_resolvedLinks.clear();
+    m_reportedUnresolvedLinks.clear();
+}
+
+/*!
+  \internal
+
+  Performs the search for findNodeForAtom().
+ */
+const Node *QDocDatabase::resolveLinkTarget(const Atom *a, const Node *relative, QString &ref,
+                                            Node::Genus genus)
 {
     const Node *node = nullptr;
 
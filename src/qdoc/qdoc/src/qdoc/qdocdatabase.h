@@ -11,7 +11,9 @@
 #include "tree.h"
 
 #include <QtCore/qdebug.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qmap.h>
+#include <QtCore/qset.h>
 #include <QtCore/qstring.h>
 
 QT_BEGIN_NAMESPACE
@@ -137,15 +139,8 @@ private:
         return nullptr;
     }
 
-    QmlTypeNode *lookupQmlType(const QString &name)
-    {
-        for (const auto *tree : searchOrder()) {
-            QmlTypeNode *qcn = tree->lookupQmlType(name);
-            if (qcn)
-                return qcn;
-        }
-        return nullptr;
-    }
+    QmlTypeNode *lookupQmlType(const QString &name);
+    QmlTypeNode *findQmlTypeByName(const QString &name);
 
     void clearSearchOrder() { m_searchOrder.clear(); }
     void newPrimaryTree(const QString &module);
@@ -160,6 +155,11 @@ private:
     QList<Tree *> m_searchOrder;
     QList<Tree *> m_indexSearchOrder;
     QList<QString> m_moduleNames;
+
+    bool updateQmlTypeIndex();
+    QList<Tree *> m_qmlTypeIndexTrees;
+    QHash<QString, QmlTypeNode *> m_qmlTypesByKey;
+    QHash<QString, QmlTypeNode *> m_qmlTypesByName;
 };
 
 class QDocDatabase
@@ -270,6 +270,8 @@ public:
     ******************************************************************************/
     const Node *findNodeForAtom(const Atom *atom, const Node *relative, QString &ref,
                                 Node::Genus genus = Node::DontCare);
+    bool isFirstUnresolvedLink(const Atom *atom, const Node *relative,
+                               const Location &location);
     /*******************************************************************/
 
     /*******************************************************************
@@ -352,7 +354,49 @@ public:
 private:
     friend class Tree;
 
+    struct LinkKey
+    {
+        QString m_target;
+        const Node *m_relative;
+        const Tree *m_domain;
+        Node::Genus m_genus;
+
+        friend bool operator==(const LinkKey &lhs, const LinkKey &rhs) noexcept
+        {
+            return lhs.m_relative == rhs.m_relative && lhs.m_domain == rhs.m_domain
+                    && lhs.m_genus == rhs.m_genus && lhs.m_target == rhs.m_target;
+        }
+        friend size_t qHash(const LinkKey &key, size_t seed = 0) noexcept
+        {
+            return qHashMulti(seed, key.m_target, key.m_relative, key.m_domain,
+                              static_cast<int>(key.m_genus));
+        }
+    };
+    struct ReportedLink
+    {
+        LinkKey m_link;
+        QString m_location;
+
+        friend bool operator==(const ReportedLink &lhs, const ReportedLink &rhs) noexcept
+        {
+            return lhs.m_link == rhs.m_link && lhs.m_location == rhs.m_location;
+        }
+        friend size_t qHash(const ReportedLink &key, size_t seed = 0) noexcept
+        {
+            return qHashMulti(seed, key.m_link, key.m_location);
+        }
+    };
+    struct ResolvedLink
+    {
+        const Node *m_node;
+        QString m_ref;
+    };
+
     void processForest(FindFunctionPtr func);
+    static LinkKey linkKey(const Atom *atom, const Node *relative, Node::Genus genus);
+    const Node *resolveLinkTarget(const Atom *atom, const Node *relative, QString &ref,
+                                  Node::Genus genus);
+    void clearLinkCache();
     bool isLoaded(const QString &t) { return m_forest.isLoaded(t); }
     static void initializeDB();
 
@@ -388,6 +432,9 @@ private:
     NodeMapMap m_functionIndex {};
     TextToNodeMap m_legaleseTexts {};
     QMultiHash<Tree*, FindFunctionPtr> m_completedFindFunctions {};
+    bool m_cacheLinks { false };
+    QHash<LinkKey, ResolvedLink> m_resolvedLinks {};
+    QSet<ReportedLink> m_reportedUnresolvedLinks {};
 };
 
 QT_END_NAMESPACE
@@ -23,9 +23,11 @@
 #include "typedefnode.h"
 #include "variablenode.h"
 
+#include <QtCore/qthreadpool.h>
 #include <QtCore/qxmlstream.h>
 
 #include <algorithm>
+#include <functional>
 
 QT_BEGIN_NAMESPACE
 
@@ -40,7 +42,8 @@ enum QDocAttr {
 };
 
 static Node *root_ = nullptr;
-static IndexSectionWriter *post_ = nullptr;
+static thread_local IndexSectionWriter *post_ = nullptr;
+static constexpr char s_childSectionsMarker[] = "qdoc-child-sections";
 
 /*!
   \class QDocIndexFiles
@@ -789,6 +792,76 @@ void QDocIndexFiles::writeTargets(QXmlStreamWriter &writer, Node *node)
     }
 }
 
+/*!
+    Returns the name of the index element written for \a node, or an
+    empty string if nodes of its type have no section of their own.
+*/
+static QString indexElementName(const Node *node)
+{
+    switch (node->nodeType()) {
+    case Node::Namespace:
+        return "namespace";
+    case Node::Class:
+        return "class";
+    case Node::Struct:
+        return "struct";
+    case Node::Union:
+        return "union";
+    case Node::HeaderFile:
+        return "header";
+    case Node::QmlType:
+        return "qmlclass";
+    case Node::QmlValueType:
+        return "qmlvaluetype";
+    case Node::Page:
+    case Node::Example:
+    case Node::ExternalPage:
+        return "page";
+    case Node::Group:
+        return "group";
+    case Node::Module:
+        return "module";
+    case Node::QmlModule:
+        return "qmlmodule";
+    case Node::Enum:
+        return "enum";
+    case Node::TypeAlias:
+    case Node::Typedef:
+        return "typedef";
+    case Node::Property:
+        return "property";
+    case Node::Variable:
+        return "variable";
+    case Node::SharedComment:
+        // Add an entry for property groups so that they can be linked to
+        return node->isPropertyGroup() ? "qmlproperty" : QString();
+    case Node::QmlProperty:
+        return "qmlproperty";
+    case Node::Proxy:
+        return "proxy";
+    case Node::Function: // Processed in generateFunctionSection()
+    default:
+        return QString();
+    }
+}
+
+/*!
+    Returns \c true if generateIndexSection() writes an element for
+    \a node.
+*/
+bool QDocIndexFiles::hasIndexSection(const Node *node) const
+{
+    // Don't include index nodes in a new index file.
+    if (node->isIndexNode())
+        return false;
+
+    if (indexElementName(node).isEmpty())
+        return false;
+
+    // Special case: only the root node should have an empty name.
+    return !node->name().isEmpty() || node == m_qdb->primaryTreeRoot();
+}
+
 /*!
   Generate the index section with the given \a writer for the \a node
   specified, returning true if an element was written, and returning
@@ -805,13 +878,10 @@ bool QDocIndexFiles::generateIndexSection(QXmlStreamWriter &writer, Node *node,
     Q_ASSERT(m_gen);
 
     post_ = nullptr;
-    /*
-      Don't include index nodes in a new index file.
-     */
-    if (node->isIndexNode())
+    if (!hasIndexSection(node))
         return false;
 
-    QString nodeName;
+    const QString nodeName = indexElementName(node);
     QString logicalModuleName;
     QString logicalModuleVersion;
     QString qmlFullBaseName;
@@ -820,83 +890,25 @@ bool QDocIndexFiles::generateIndexSection(QXmlStreamWriter &writer, Node *node,
     QString moduleVerAttr;
 
     switch (node->nodeType()) {
-    case Node::Namespace:
-        nodeName = "namespace";
-        break;
-    case Node::Class:
-        nodeName = "class";
-        break;
-    case Node::Struct:
-        nodeName = "struct";
-        break;
-    case Node::Union:
-        nodeName = "union";
-        break;
-    case Node::HeaderFile:
-        nodeName = "header";
-        break;
     case Node::QmlType:
     case Node::QmlValueType:
-        nodeName = (node->nodeType() == Node::QmlType) ? "qmlclass" : "qmlvaluetype";
         logicalModuleName = node->logicalModuleName();
         baseNameAttr = "qml-base-type";
         moduleNameAttr = "qml-module-name";
         moduleVerAttr = "qml-module-version";
         qmlFullBaseName = node->qmlFullBaseName();
         break;
-    case Node::Page:
-    case Node::Example:
-    case Node::ExternalPage:
-        nodeName = "page";
-        break;
-    case Node::Group:
-        nodeName = "group";
-        break;
-    case Node::Module:
-        nodeName = "module";
-        break;
     case Node::QmlModule:
-        nodeName = "qmlmodule";
         moduleNameAttr = "qml-module-name";
         moduleVerAttr = "qml-module-version";
         logicalModuleName = node->logicalModuleName();
         logicalModuleVersion = node->logicalModuleVersion();
         break;
-    case Node::Enum:
-        nodeName = "enum";
-        break;
-    case Node::TypeAlias:
-    case Node::Typedef:
-        nodeName = "typedef";
-        break;
-    case Node::Property:
-        nodeName = "property";
-        break;
-    case Node::Variable:
-        nodeName = "variable";
-        break;
-    case Node::SharedComment:
-        if (!node->isPropertyGroup())
-            return false;
-        // Add an entry for property groups so that they can be linked to
-        nodeName = "qmlproperty";
-        break;
-    case Node::QmlProperty:
-        nodeName = "qmlproperty";
-        break;
-    case Node::Proxy:
-        nodeName = "proxy";
-        break;
-    case Node::Function: // Now processed in generateFunctionSection()
     default:
-        return false;
+        break;
     }
 
     QString objName = node->name();
-    // Special case: only the root node should have an empty name.
-    if (objName.isEmpty() && node != m_qdb->primaryTreeRoot())
-        return false;
-
     writer.writeStartElement(nodeName);
 
     if (!node->isTextPageNode() && !node->isCollectionNode() && !node->isHeader()) {
@@ -1368,7 +1380,11 @@ void QDocIndexFiles::generateIndexSections(QXmlStreamWriter &writer, Node *node,
         return;
 
     if (generateIndexSection(writer, node, post)) {
-        if (node->isAggregate()) {
+        if (node == root_ && !m_childSections.isEmpty()) {
+            // The children of the root were serialized by
+            // generateChildSections(); mark where they belong.
+            writer.writeEmptyElement(s_childSectionsMarker);
+        } else if (node->isAggregate()) {
             auto *aggregate = static_cast<Aggregate *>(node);
             // First write the function children, then write the nonfunction children.
             generateFunctionSections(writer, aggregate);
@@ -1415,11 +1431,122 @@ void QDocIndexFiles::generateIndexSections(QXmlStreamWriter &writer, Node *node,
     }
 }
 
+/*!
+  Walks the subtree of \a node in the order generateIndexSections()
+  visits it, and does the parts of writing the index that modify
+  shared state: it computes the document location of each node,
+  which caches file name bases in the tree, and numbers the related
+  non-members. Afterwards, the sections can be written concurrently.
+ */
+void QDocIndexFiles::prepareIndexSections(Node *node)
+{
+    if (node->isCollectionNode() || node->isGroup() || node->isModule() || node->isQmlModule())
+        return;
+
+    if (node->isInternal() && !Config::instance().showInternal())
+        return;
+
+    if (!hasIndexSection(node))
+        return;
+
+    if (!node->isExternalPage())
+        m_gen->fullDocumentLocation(node);
+    if (node->isRelatedNonmember())
+        indexForNode(node);
+
+    if (node->isAggregate()) {
+        auto *aggregate = static_cast<Aggregate *>(node);
+        for (const auto &functions : std::as_const(aggregate->functionMap())) {
+            for (auto *fn : functions) {
+                if (fn->isInternal() && !Config::instance().showInternal())
+                    continue;
+                m_gen->fullDocumentLocation(fn);
+                if (fn->isRelatedNonmember())
+                    indexForNode(fn);
+            }
+        }
+        for (auto *child : aggregate->nonfunctionList())
+            prepareIndexSections(child);
+    }
+}
+
+/*!
+  Returns the output of \a write, called with a writer whose
+  automatic formatting is indented for elements at \a depth.
+ */
+static QByteArray writeNestedSections(int depth,
+                                      const std::function<void(QXmlStreamWriter &)> &write)
+{
+    QByteArray data;
+    QXmlStreamWriter writer(&data);
+    writer.setAutoFormatting(true);
+    for (int i = 0; i < depth; ++i)
+        writer.writeStartElement("scope");
+
+    const qsizetype begin = data.size();
+    write(writer);
+    if (data.size() == begin)
+        return QByteArray();
+
+    // The first child closes the start tag of the enclosing scope.
+    Q_ASSERT(data.at(begin) == '>');
+    return data.sliced(begin + 1);
+}
+
+/*!
+  Serializes the children of the root node concurrently, one
+  top-level aggregate per task, into m_childSections. The sections
+  are stored in tree order, with the function children of the root
+  first, so that concatenating them yields what generateIndexSections()
+  would write for the children.
+
+  If the root has no children that appear in the index,
+  m_childSections is left empty.
+ */
+void QDocIndexFiles::generateChildSections()
+{
+    m_childSections.clear();
+    if (!root_->isAggregate() || !hasIndexSection(root_))
+        return;
+
+    prepareIndexSections(root_);
+
+    auto *root = static_cast<Aggregate *>(root_);
+    const NodeList &children = root->nonfunctionList();
+    // Root (and children) are nested in <INDEX>
+    constexpr int depth = 2;
+    QList<QByteArray> sections(children.size() + 1);
+    QByteArray *results = sections.data();
+
+    QThreadPool pool;
+    pool.start([this, root, results] {
+        results[0] = writeNestedSections(depth, [this, root](QXmlStreamWriter &writer) {
+            generateFunctionSections(writer, root);
+        });
+    });
+    for (qsizetype i = 0; i < children.size(); ++i) {
+        Node *child = children.at(i);
+        pool.start([this, child, results, i] {
+            results[i + 1] = writeNestedSections(depth, [this, child](QXmlStreamWriter &writer) {
+                generateIndexSections(writer, child, nullptr);
+            });
+        });
+    }
+    pool.waitForDone();
+
+    if (std::any_of(sections.cbegin(), sections.cend(),
+                    [](const QByteArray &section) { return !section.isEmpty(); }))
+        m_childSections = sections;
+}
+
 /*!
   Writes a qdoc module index in XML to a file named \a fileName.
   \a url is the \c url attribute of the <INDEX> element.
   \a title is the \c title attribute of the <INDEX> element.
   \a g is a pointer to the current Generator in use, stored for later use.
+
+  The sections for the children of the root node are generated
+  concurrently and spliced into the output in tree order.
  */
 void QDocIndexFiles::generateIndex(const QString &fileName, const QString &url,
                                    const QString &title, Generator *g)
@@ -1432,7 +1559,11 @@ void QDocIndexFiles::generateIndex(const QString &fileName, const QString &url,
 
     m_gen = g;
     m_relatedNodes.clear();
-    QXmlStreamWriter writer(&file);
+    root_ = m_qdb->primaryTreeRoot();
+    generateChildSections();
+
+    QByteArray data;
+    QXmlStreamWriter writer(&data);
     writer.setAutoFormatting(true);
     writer.writeStartDocument();
     writer.writeDTD("<!DOCTYPE QDOCINDEX>");
@@ -1443,7 +1574,6 @@ void QDocIndexFiles::generateIndex(const QString &fileName, const QString &url,
     writer.writeAttribute("version", m_qdb->version());
     writer.writeAttribute("project", Config::instance().get(CONFIG_PROJECT).asString());
 
-    root_ = m_qdb->primaryTreeRoot();
     if (!root_->tree()->indexTitle().isEmpty())
         writer.writeAttribute("indexTitle", root_->tree()->indexTitle());
 
@@ -1452,6 +1582,22 @@ void QDocIndexFiles::generateIndex(const QString &fileName, const QString &url,
     writer.writeEndElement(); // INDEX
     writer.writeEndElement(); // QDOCINDEX
     writer.writeEndDocument();
+
+    if (m_childSections.isEmpty()) {
+        file.write(data);
+    } else {
+        // Replace the marker element, including its indentation,
+        // with the child sections.
+        qsizetype end = data.indexOf(s_childSectionsMarker);
+        Q_ASSERT(end > 0 && data.at(end - 1) == '<');
+        qsizetype begin = data.lastIndexOf('\n', end);
+        end = data.indexOf('>', end) + 1;
+        file.write(data.constData(), begin);
+        for (const QByteArray &section : std::as_const(m_childSections))
+            file.write(section);
+        file.write(data.constData() + end, data.size() - end);
+        m_childSections.clear();
+    }
     file.close();
 }
 
@@ -47,9 +47,12 @@ private:
     int indexForNode(Node *node);
     bool adoptRelatedNode(Aggregate *adoptiveParent, int index);
     void writeTargets(QXmlStreamWriter &writer, Node *node);
+    bool hasIndexSection(const Node *node) const;
 
     void generateIndex(const QString &fileName, const QString &url, const QString &title,
                        Generator *g);
+    void prepareIndexSections(Node *node);
+    void generateChildSections();
     void generateFunctionSection(QXmlStreamWriter &writer, FunctionNode *fn);
     void generateFunctionSections(QXmlStreamWriter &writer, Aggregate *aggregate);
     bool generateIndexSection(QXmlStreamWriter &writer, Node *node,
@@ -65,6 +68,7 @@ private:
     QString m_project;
     QList<std::pair<ClassNode *, QString>> m_basesList;
     NodeList m_relatedNodes;
+    QList<QByteArray> m_childSections;
     bool m_storeLocationInfo;
 };
 
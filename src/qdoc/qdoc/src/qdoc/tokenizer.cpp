@@ -785,4 +785,13 @@ QString Tokenizer::previousLexeme() const
     return sourceDecoder(m_prevLex);
 }
 
+/*!
+  Returns \a source decoded with the configured source encoding, as
+  lexeme() decodes the current token.
+ */
+QString Tokenizer::decodeSource(QByteArrayView source)
+{
+    return sourceDecoder(source);
+}
+
 QT_END_NAMESPACE
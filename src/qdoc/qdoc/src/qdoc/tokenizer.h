@@ -97,6 +97,7 @@ public:
     static void initialize();
     static void terminate();
     static bool isTrue(const QString &condition);
+    static QString decodeSource(QByteArrayView source);
 
 private:
     void init();
@@ -154,6 +154,7 @@ private: // The rest of the class is private.
         return m_qmlTypeMap.value(name);
     }
     void insertQmlType(const QString &key, QmlTypeNode *n);
+    [[nodiscard]] const QmlTypeMap &qmlTypeMap() const { return m_qmlTypeMap; }
     void addExampleNode(ExampleNode *n) { m_exampleNodeMap.insert(n->title(), n); }
     ExampleNodeMap &exampleNodeMap() { return m_exampleNodeMap; }
     void setIndexFileName(const QString &t) { m_indexFileName = t; }
@@ -0,0 +1,406 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "xmlwriter.h"
+
+#include <QtCore/qiodevice.h>
+
+#include <algorithm>
+#include <type_traits>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+/*!
+  \class XmlWriter
+  \internal
+  \brief The XmlWriter class writes XML documents the way
+  QXmlStreamWriter does without auto-formatting, with less overhead.
+
+  The DocBook generator writes every page through a long sequence of
+  small calls: one per element, attribute, and text fragment. This
+  writer encodes the output directly into a UTF-8 buffer, which it
+  hands to the device in large blocks, rather than converting and
+  writing each fragment separately. Namespace prefixes are stored
+  once, as UTF-8, when they are declared.
+
+  The output is byte-for-byte the same as that of QXmlStreamWriter
+  for the subset of its API that is provided here, including the
+  generated \c{n}\e{N} prefixes for undeclared namespaces.
+*/
+
+static constexpr qsizetype FlushThreshold = 64 * 1024;
+
+/*!
+  Constructs a writer that writes to \a device. The output is buffered
+  until the buffer is full, writeEndDocument() is called, or flush()
+  is called explicitly.
+*/
+XmlWriter::XmlWriter(QIODevice *device) : m_device(device), m_buffer(&m_ownBuffer)
+{
+    m_ownBuffer.reserve(FlushThreshold + 1024);
+}
+
+/*!
+  Constructs a writer that appends to \a array.
+*/
+XmlWriter::XmlWriter(QByteArray *array) : m_buffer(array) { }
+
+/*!
+  Makes the namespace declarations that are in scope in \a other
+  known to this writer, without writing them. Use this when the
+  output of this writer is to be inserted into that of \a other
+  with writeRawData().
+*/
+void XmlWriter::declareNamespaces(const XmlWriter &other)
+{
+    m_namespaceDeclarations = other.m_namespaceDeclarations;
+    m_lastNamespaceDeclaration = m_namespaceDeclarations.size();
+    m_namespacePrefixCount = other.m_namespacePrefixCount;
+}
+
+void XmlWriter::writeStartDocument()
+{
+    finishStartElement();
+    m_buffer->append("<?xml version=\"1.0\"");
+    if (m_device)
+        m_buffer->append(" encoding=\"UTF-8\"");
+    m_buffer->append("?>");
+}
+
+/*!
+  Closes all remaining open elements, writes a final line feed, and
+  flushes the output to the device.
+*/
+void XmlWriter::writeEndDocument()
+{
+    while (!m_elements.isEmpty())
+        writeEndElement();
+    m_buffer->append('\n');
+    flush();
+}
+
+/*!
+  Declares \a prefix for \a namespaceUri. If an element is being
+  started, the declaration is written as part of it; otherwise, it is
+  written with the next start element.
+*/
+void XmlWriter::writeNamespace(QAnyStringView namespaceUri, QAnyStringView prefix)
+{
+    if (prefix.isEmpty()) {
+        findNamespace(namespaceUri, m_inStartElement, false);
+        return;
+    }
+
+    m_namespaceDeclarations.append({ namespaceUri.toString(), prefix.toString().toUtf8() });
+    if (m_inStartElement)
+        writeNamespaceDeclaration(m_namespaceDeclarations.constLast());
+}
+
+void XmlWriter::writeStartElement(QAnyStringView namespaceUri, QAnyStringView name)
+{
+    finishStartElement();
+
+    const QByteArray &prefix = findNamespace(namespaceUri, false, false).m_prefix;
+    QByteArray qualifiedName;
+    if (!prefix.isEmpty()) {
+        qualifiedName.reserve(prefix.size() + 1 + name.size());
+        qualifiedName.append(prefix).append(':');
+    }
+    qualifiedName.append(name.toString().toUtf8());
+
+    m_buffer->append('<').append(qualifiedName);
+    m_inStartElement = true;
+
+    for (qsizetype i = m_lastNamespaceDeclaration; i < m_namespaceDeclarations.size(); ++i)
+        writeNamespaceDeclaration(m_namespaceDeclarations.at(i));
+    m_elements.append({ std::move(qualifiedName), m_lastNamespaceDeclaration });
+}
+
+void XmlWriter::writeEmptyElement(QAnyStringView namespaceUri, QAnyStringView name)
+{
+    writeStartElement(namespaceUri, name);
+    m_inEmptyElement = true;
+}
+
+void XmlWriter::writeEndElement()
+{
+    if (m_elements.isEmpty())
+        return;
+
+    if (m_inStartElement && !m_inEmptyElement) {
+        m_buffer->append("/>");
+        m_inStartElement = false;
+        popElement();
+        flushIfFull();
+        return;
+    }
+
+    finishStartElement();
+    if (m_elements.isEmpty())
+        return;
+
+    m_buffer->append("</").append(m_elements.constLast().m_qualifiedName).append('>');
+    popElement();
+    flushIfFull();
+}
+
+void XmlWriter::writeTextElement(QAnyStringView namespaceUri, QAnyStringView name,
+                                 QAnyStringView text)
+{
+    writeStartElement(namespaceUri, name);
+    writeCharacters(text);
+    writeEndElement();
+}
+
+void XmlWriter::writeAttribute(QAnyStringView qualifiedName, QAnyStringView value)
+{
+    Q_ASSERT(m_inStartElement);
+    m_buffer->append(' ');
+    write(qualifiedName);
+    m_buffer->append("=\"");
+    writeEscaped(value, true);
+    m_buffer->append('"');
+}
+
+void XmlWriter::writeAttribute(QAnyStringView namespaceUri, QAnyStringView name,
+                               QAnyStringView value)
+{
+    Q_ASSERT(m_inStartElement);
+    const QByteArray &prefix = findNamespace(namespaceUri, true, true).m_prefix;
+    m_buffer->append(' ');
+    if (!prefix.isEmpty())
+        m_buffer->append(prefix).append(':');
+    write(name);
+    m_buffer->append("=\"");
+    writeEscaped(value, true);
+    m_buffer->append('"');
+}
+
+void XmlWriter::writeCharacters(QAnyStringView text)
+{
+    finishStartElement();
+    writeEscaped(text, false);
+    flushIfFull();
+}
+
+/*!
+  Writes \a data, which must be UTF-8 encoded, well-formed XML, as is.
+  A pending start tag is closed first.
+*/
+void XmlWriter::writeRawData(QByteArrayView data)
+{
+    finishStartElement();
+    m_buffer->append(data);
+    flushIfFull();
+}
+
+/*!
+  Writes the buffered output to the device, if any.
+*/
+void XmlWriter::flush()
+{
+    if (!m_device || m_ownBuffer.isEmpty())
+        return;
+    m_device->write(m_ownBuffer);
+    m_ownBuffer.resize(0);
+}
+
+/*!
+  \internal
+
+  Returns the declaration in scope for \a namespaceUri. If there is
+  none, a prefix is generated and declared, and if \a writeDeclaration
+  is \c true, the declaration is written immediately. With \a
+  noDefault, as for attributes, the default namespace declaration is
+  not considered.
+*/
+const XmlWriter::NamespaceDeclaration &
+XmlWriter::findNamespace(QAnyStringView namespaceUri, bool writeDeclaration, bool noDefault)
+{
+    for (qsizetype i = m_namespaceDeclarations.size() - 1; i >= 0; --i) {
+        const NamespaceDeclaration &declaration = m_namespaceDeclarations.at(i);
+        if (QAnyStringView::equal(declaration.m_namespaceUri, namespaceUri)
+            && (!noDefault || !declaration.m_prefix.isEmpty()))
+            return declaration;
+    }
+
+    if (namespaceUri.isEmpty()) {
+        static const NamespaceDeclaration emptyNamespace;
+        return emptyNamespace;
+    }
+
+    QByteArray prefix;
+    int n = ++m_namespacePrefixCount;
+    for (;;) {
+        prefix = 'n' + QByteArray::number(n++);
+        auto sameName = [&prefix](const NamespaceDeclaration &declaration) {
+            return declaration.m_prefix == prefix;
+        };
+        if (std::none_of(m_namespaceDeclarations.cbegin(), m_namespaceDeclarations.cend(), sameName))
+            break;
+    }
+
+    m_namespaceDeclarations.append({ namespaceUri.toString(), std::move(prefix) });
+    if (writeDeclaration)
+        writeNamespaceDeclaration(m_namespaceDeclarations.constLast());
+    return m_namespaceDeclarations.constLast();
+}
+
+void XmlWriter::writeNamespaceDeclaration(const NamespaceDeclaration &declaration)
+{
+    if (declaration.m_prefix.isEmpty())
+        m_buffer->append(" xmlns=\"");
+    else
+        m_buffer->append(" xmlns:").append(declaration.m_prefix).append("=\"");
+    append(QStringView{declaration.m_namespaceUri});
+    m_buffer->append('"');
+}
+
+/*!
+  \internal
+
+  Closes a pending start tag, or the tag of a pending empty element.
+*/
+void XmlWriter::finishStartElement()
+{
+    if (!m_inStartElement)
+        return;
+
+    if (m_inEmptyElement) {
+        m_buffer->append("/>");
+        popElement();
+        m_inEmptyElement = false;
+    } else {
+        m_buffer->append('>');
+    }
+    m_inStartElement = false;
+    m_lastNamespaceDeclaration = m_namespaceDeclarations.size();
+}
+
+void XmlWriter::popElement()
+{
+    m_lastNamespaceDeclaration = m_elements.constLast().m_namespaceDeclarationsSize;
+    m_namespaceDeclarations.resize(m_lastNamespaceDeclaration);
+    m_elements.removeLast();
+}
+
+void XmlWriter::write(QAnyStringView text)
+{
+    text.visit([this](auto view) { append(view); });
+}
+
+void XmlWriter::append(QLatin1StringView text)
+{
+    for (char c : text) {
+        const auto u = static_cast<uchar>(c);
+        if (u < 0x80) {
+            m_buffer->append(c);
+        } else {
+            m_buffer->append(char(0xc0 | (u >> 6)));
+            m_buffer->append(char(0x80 | (u & 0x3f)));
+        }
+    }
+}
+
+void XmlWriter::append(QUtf8StringView text)
+{
+    m_buffer->append(text.data(), text.size());
+}
+
+void XmlWriter::append(QStringView text)
+{
+    const qsizetype size = m_buffer->size();
+    m_buffer->resize(size + m_encoder.requiredSpace(text.size()));
+    char *end = m_encoder.appendToBuffer(m_buffer->data() + size, text);
+    m_buffer->resize(end - m_buffer->constData());
+}
+
+void XmlWriter::writeEscaped(QAnyStringView text, bool inAttribute)
+{
+    text.visit([this, inAttribute](auto view) { writeEscapedView(view, inAttribute); });
+}
+
+/*!
+  \internal
+
+  Writes \a text with the characters that are special in XML replaced
+  by entity or character references, as QXmlStreamWriter does. Tabs
+  and line breaks are only replaced in attribute values, that is, if
+  \a inAttribute is \c true. Other control characters cannot be
+  represented in XML 1.0 and are dropped.
+
+  All of these characters are ASCII, so runs of characters that need
+  no replacement are found by looking at single code units and
+  appended in one go.
+*/
+template <typename View>
+void XmlWriter::writeEscapedView(View text, bool inAttribute)
+{
+    qsizetype runStart = 0;
+    const qsizetype size = text.size();
+    for (qsizetype i = 0; i < size; ++i) {
+        char32_t c;
+        if constexpr (std::is_same_v<View, QStringView>)
+            c = text.utf16()[i];
+        else
+            c = static_cast<uchar>(text.data()[i]);
+        if (c > u'>' && c != 0xfffe && c != 0xffff)
+            continue;
+
+        QLatin1StringView replacement;
+        switch (c) {
+        case u'<':
+            replacement = "&lt;"_L1;
+            break;
+        case u'>':
+            replacement = "&gt;"_L1;
+            break;
+        case u'&':
+            replacement = "&amp;"_L1;
+            break;
+        case u'"':
+            replacement = "&quot;"_L1;
+            break;
+        case u'\t':
+            if (!inAttribute)
+                continue;
+            replacement = "&#9;"_L1;
+            break;
+        case u'\n':
+            if (!inAttribute)
+                continue;
+            replacement = "&#10;"_L1;
+            break;
+        case u'\r':
+            if (!inAttribute)
+                continue;
+            replacement = "&#13;"_L1;
+            break;
+        default:
+            if (c >= 0x20 && c < 0xfffe)
+                continue;
+            break;
+        }
+
+        append(text.sliced(runStart, i - runStart));
+        m_buffer->append(replacement.data(), replacement.size());
+        runStart = i + 1;
+    }
+    append(text.sliced(runStart));
+}
+
+/*!
+  \internal
+
+  Writes the buffered output to the device once the buffer has grown
+  past the flush threshold.
+*/
+void XmlWriter::flushIfFull()
+{
+    if (m_device && m_ownBuffer.size() >= FlushThreshold)
+        flush();
+}
+
+QT_END_NAMESPACE
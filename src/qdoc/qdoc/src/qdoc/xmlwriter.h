@@ -0,0 +1,81 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef XMLWRITER_H
+#define XMLWRITER_H
+
+#include <QtCore/qanystringview.h>
+#include <QtCore/qbytearray.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringconverter.h>
+
+QT_BEGIN_NAMESPACE
+
+class QIODevice;
+
+class XmlWriter
+{
+public:
+    explicit XmlWriter(QIODevice *device);
+    explicit XmlWriter(QByteArray *array);
+    XmlWriter(const XmlWriter &) = delete;
+    XmlWriter &operator=(const XmlWriter &) = delete;
+
+    [[nodiscard]] QIODevice *device() const { return m_device; }
+    void declareNamespaces(const XmlWriter &other);
+
+    void writeStartDocument();
+    void writeEndDocument();
+    void writeNamespace(QAnyStringView namespaceUri, QAnyStringView prefix);
+    void writeStartElement(QAnyStringView namespaceUri, QAnyStringView name);
+    void writeEmptyElement(QAnyStringView namespaceUri, QAnyStringView name);
+    void writeEndElement();
+    void writeTextElement(QAnyStringView namespaceUri, QAnyStringView name, QAnyStringView text);
+    void writeAttribute(QAnyStringView qualifiedName, QAnyStringView value);
+    void writeAttribute(QAnyStringView namespaceUri, QAnyStringView name, QAnyStringView value);
+    void writeCharacters(QAnyStringView text);
+    void writeRawData(QByteArrayView data);
+    void flush();
+
+private:
+    struct NamespaceDeclaration
+    {
+        QString m_namespaceUri;
+        QByteArray m_prefix;
+    };
+    struct Element
+    {
+        QByteArray m_qualifiedName;
+        qsizetype m_namespaceDeclarationsSize;
+    };
+
+    const NamespaceDeclaration &findNamespace(QAnyStringView namespaceUri, bool writeDeclaration,
+                                              bool noDefault);
+    void writeNamespaceDeclaration(const NamespaceDeclaration &declaration);
+    void finishStartElement();
+    void popElement();
+    void write(QAnyStringView text);
+    void append(QLatin1StringView text);
+    void append(QUtf8StringView text);
+    void append(QStringView text);
+    void writeEscaped(QAnyStringView text, bool inAttribute);
+    template <typename View>
+    void writeEscapedView(View text, bool inAttribute);
+    void flushIfFull();
+
+    QIODevice *m_device { nullptr };
+    QByteArray m_ownBuffer {};
+    QByteArray *m_buffer { nullptr };
+    QStringEncoder m_encoder { QStringEncoder::Utf8, QStringEncoder::Flag::Stateless };
+    QList<NamespaceDeclaration> m_namespaceDeclarations {};
+    qsizetype m_lastNamespaceDeclaration { 0 };
+    int m_namespacePrefixCount { 0 };
+    QList<Element> m_elements {};
+    bool m_inStartElement { false };
+    bool m_inEmptyElement { false };
+};
+
+QT_END_NAMESPACE
+
+#endif // XMLWRITER_H
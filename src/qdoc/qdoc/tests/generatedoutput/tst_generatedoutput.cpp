@@ -4,6 +4,11 @@
 #include <QTemporaryDir>
 #include <QDirIterator>
 #include <QtTest>
+#ifdef QT_SQL_LIB
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlRecord>
+#endif
 
 class tst_generatedOutput : public QObject
 {
@@ -28,6 +33,8 @@ private slots:
     void preparePhase();
     void generatePhase();
     void noAutoList();
+    void preprocessorInQdocFiles();
+    void qchFile();
 
 private:
     QScopedPointer<QTemporaryDir> m_outputDir;
@@ -269,6 +276,95 @@ void tst_generatedOutput::noAutoList()
                    "noautolist-docbook/qdoc-test-qmlmodule.xml");
 }
 
+void tst_generatedOutput::preprocessorInQdocFiles()
+{
+    // Qdoc comments in excluded branches must be skipped; any warnings,
+    // such as duplicate pages or broken links, make QDoc fail.
+    runQDocProcess({ "-outputdir", m_outputDir->path() + "/",
+                     QFINDTESTDATA("testdata/preprocessor/preprocessor.qdocconf") });
+    if (QTest::currentTestFailed())
+        return;
+
+    QVERIFY(QFileInfo::exists(m_outputDir->filePath("preprocessor/preprocessor.html")));
+    QVERIFY(QFileInfo::exists(m_outputDir->filePath("preprocessor/defined.html")));
+    QVERIFY(!QFileInfo::exists(m_outputDir->filePath("preprocessor/disabled.html")));
+}
+
+void tst_generatedOutput::qchFile()
+{
+#ifndef QT_SQL_LIB
+    QSKIP("Reading Qt compressed help files requires Qt SQL.");
+#else
+    const auto extension = QSysInfo::productType() == "windows" ? ".exe" : "";
+    const QString qhelpgenerator = QLibraryInfo::path(QLibraryInfo::LibraryExecutablesPath)
+            + QLatin1String("/qhelpgenerator") + extension;
+    if (!QFileInfo::exists(qhelpgenerator))
+        QSKIP("qhelpgenerator is not available.");
+
+    // The pages in extra/ are listed in the help project, but not generated
+    const QDir outputDir(m_outputDir->filePath("qch"));
+    QVERIFY(outputDir.mkpath("extra"));
+    const QDir extraDir(QFINDTESTDATA("testdata/qch/extra"));
+    for (const QString &page : extraDir.entryList(QDir::Files))
+        QVERIFY(QFile::copy(extraDir.filePath(page), outputDir.filePath("extra/" + page)));
+
+    // QDoc writes both qchtest.qhp and qchtest.qch
+    runQDocProcess({ "-outputdir", m_outputDir->path() + "/",
+                     QFINDTESTDATA("testdata/qch/qch.qdocconf") });
+    if (QTest::currentTestFailed())
+        return;
+
+    const QString expectedQch = m_outputDir->filePath("qhelpgenerator.qch");
+    QProcess qhelpgeneratorProcess;
+    qhelpgeneratorProcess.setProcessChannelMode(QProcess::MergedChannels);
+    qhelpgeneratorProcess.start(qhelpgenerator,
+                                { outputDir.filePath("qchtest.qhp"), "-o", expectedQch });
+    QVERIFY(qhelpgeneratorProcess.waitForFinished());
+    QVERIFY2(qhelpgeneratorProcess.exitCode() == 0,
+             qhelpgeneratorProcess.readAll().constData());
+
+    // Every table must have the same rows, in the same order
+    auto rows = [](const QSqlDatabase &db, const QString &table) {
+        QList<QVariantList> result;
+        QSqlQuery query(QStringLiteral("SELECT * FROM %1").arg(table), db);
+        while (query.next()) {
+            QVariantList row;
+            for (int i = 0; i < query.record().count(); ++i)
+                row.append(query.value(i));
+            result.append(row);
+        }
+        return result;
+    };
+
+    {
+        QSqlDatabase actual = QSqlDatabase::addDatabase("QSQLITE", "actual");
+        actual.setDatabaseName(outputDir.filePath("qchtest.qch"));
+        QVERIFY(actual.open());
+        QSqlDatabase expected = QSqlDatabase::addDatabase("QSQLITE", "expected");
+        expected.setDatabaseName(expectedQch);
+        QVERIFY(expected.open());
+
+        QStringList tables = expected.tables();
+        tables.sort();
+        QStringList actualTables = actual.tables();
+        actualTables.sort();
+        QCOMPARE(actualTables, tables);
+
+        for (const QString &table : std::as_const(tables)) {
+            const QList<QVariantList> actualRows = rows(actual, table);
+            const QList<QVariantList> expectedRows = rows(expected, table);
+            QVERIFY2(actualRows.size() == expectedRows.size(), qPrintable(table));
+            for (qsizetype i = 0; i < expectedRows.size(); ++i) {
+                QVERIFY2(actualRows.at(i) == expectedRows.at(i),
+                         qPrintable(QStringLiteral("%1, row %2").arg(table).arg(i)));
+            }
+        }
+    }
+    QSqlDatabase::removeDatabase("actual");
+    QSqlDatabase::removeDatabase("expected");
+#endif
+}
+
 int main(int argc, char *argv[])
 {
     tst_generatedOutput tc;
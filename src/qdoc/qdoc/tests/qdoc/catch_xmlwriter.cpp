@@ -0,0 +1,231 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <catch_conversions/qdoc_catch_conversions.h>
+
+#include <catch/catch.hpp>
+
+#include <qdoc/xmlwriter.h>
+
+#include <QBuffer>
+#include <QByteArray>
+#include <QString>
+#include <QXmlStreamWriter>
+
+using namespace Qt::StringLiterals;
+
+// Runs `write` on an XmlWriter and on a QXmlStreamWriter, which
+// XmlWriter must match byte for byte, and returns both outputs.
+template <typename Write>
+static std::pair<QByteArray, QByteArray> write_both(Write write)
+{
+    QByteArray actual;
+    {
+        XmlWriter writer{&actual};
+        write(writer);
+    }
+
+    QByteArray expected;
+    {
+        QXmlStreamWriter writer{&expected};
+        write(writer);
+    }
+
+    return { actual, expected };
+}
+
+SCENARIO("Escaping text and attribute values", "[XmlWriter][Escaping]") {
+    GIVEN("Text containing markup and control characters") {
+        const QString text = u"a<b>&\"c\"\t\n\rü"_s;
+
+        WHEN("It is written as character data") {
+            auto [actual, expected] = write_both([&text](auto &writer) {
+                writer.writeStartElement(QString(), "e"_L1);
+                writer.writeCharacters(text);
+                writer.writeEndElement();
+            });
+
+            THEN("Markup is replaced by entity references, and tabs and line breaks are kept") {
+                REQUIRE(actual == "<e>a&lt;b&gt;&amp;&quot;c&quot;\t\n\r\xc3\xbc</e>");
+                REQUIRE(actual == expected);
+            }
+        }
+
+        WHEN("It is written as an attribute value") {
+            auto [actual, expected] = write_both([&text](auto &writer) {
+                writer.writeEmptyElement(QString(), "e"_L1);
+                writer.writeAttribute("v"_L1, text);
+                writer.writeEndElement();
+            });
+
+            THEN("Tabs and line breaks are replaced by character references as well") {
+                REQUIRE(actual == "<e v=\"a&lt;b&gt;&amp;&quot;c&quot;&#9;&#10;&#13;\xc3\xbc\"/>");
+                REQUIRE(actual == expected);
+            }
+        }
+
+        WHEN("It contains control characters other than tabs and line breaks") {
+            QByteArray output;
+            {
+                XmlWriter writer{&output};
+                writer.writeCharacters(u"a\x01\x1f"_s);
+                writer.writeEmptyElement(QString(), "e"_L1);
+                writer.writeAttribute("v"_L1, u"b\x01\x1f"_s);
+                writer.writeEndElement();
+            }
+
+            THEN("They are dropped, as they cannot be represented in XML 1.0") {
+                REQUIRE(output == "a<e v=\"b\"/>");
+            }
+        }
+
+        WHEN("It is passed as Latin-1, UTF-8, and UTF-16 strings") {
+            QByteArray latin1_output, utf8_output, utf16_output;
+            {
+                XmlWriter writer{&latin1_output};
+                writer.writeCharacters(QLatin1StringView("x<\xfc"));
+            }
+            {
+                XmlWriter writer{&utf8_output};
+                writer.writeCharacters(QUtf8StringView("x<\xc3\xbc"));
+            }
+            {
+                XmlWriter writer{&utf16_output};
+                writer.writeCharacters(u"x<ü"_s);
+            }
+
+            THEN("The output is the same UTF-8 for each of them") {
+                REQUIRE(latin1_output == "x&lt;\xc3\xbc");
+                REQUIRE(utf8_output == latin1_output);
+                REQUIRE(utf16_output == latin1_output);
+            }
+        }
+    }
+}
+
+SCENARIO("Writing raw data", "[XmlWriter][RawData]") {
+    GIVEN("An element whose start tag is still open") {
+        QByteArray output;
+        XmlWriter writer{&output};
+        writer.writeStartElement(QString(), "a"_L1);
+        writer.writeAttribute("x"_L1, "1"_L1);
+
+        WHEN("Raw data is written") {
+            writer.writeRawData("<b/>");
+            writer.writeEndElement();
+
+            THEN("The start tag is closed before the data, and the data is written as is") {
+                REQUIRE(output == "<a x=\"1\"><b/></a>");
+            }
+        }
+    }
+
+    GIVEN("An empty element that is still open") {
+        QByteArray output;
+        XmlWriter writer{&output};
+        writer.writeStartElement(QString(), "a"_L1);
+        writer.writeEmptyElement(QString(), "e"_L1);
+
+        WHEN("Raw data is written") {
+            writer.writeRawData("&amp;");
+            writer.writeEndElement();
+
+            THEN("The empty element is closed before the data") {
+                REQUIRE(output == "<a><e/>&amp;</a>");
+            }
+        }
+    }
+}
+
+SCENARIO("Declaring namespaces", "[XmlWriter][Namespaces]") {
+    const QString db = u"http://docbook.org/ns/docbook"_s;
+    const QString xlink = u"http://www.w3.org/1999/xlink"_s;
+
+    GIVEN("A namespace declared with a prefix") {
+        WHEN("Elements and attributes in it and in an undeclared namespace are written") {
+            auto [actual, expected] = write_both([&](auto &writer) {
+                writer.writeNamespace(db, "db"_L1);
+                writer.writeStartElement(db, "article"_L1);
+                writer.writeStartElement(db, "link"_L1);
+                writer.writeAttribute(xlink, "href"_L1, "a.html"_L1);
+                writer.writeEndElement();
+                writer.writeStartElement(db, "link"_L1);
+                writer.writeAttribute(xlink, "href"_L1, "b.html"_L1);
+                writer.writeEndElement();
+                writer.writeEndElement();
+            });
+
+            THEN("The declared prefix is used, and a prefix is generated and declared on each element that needs it") {
+                REQUIRE(actual == "<db:article xmlns:db=\"http://docbook.org/ns/docbook\">"
+                                  "<db:link xmlns:n1=\"http://www.w3.org/1999/xlink\" n1:href=\"a.html\"/>"
+                                  "<db:link xmlns:n2=\"http://www.w3.org/1999/xlink\" n2:href=\"b.html\"/>"
+                                  "</db:article>");
+                REQUIRE(actual == expected);
+            }
+        }
+    }
+
+    GIVEN("A writer whose output is inserted into that of another writer") {
+        QByteArray output;
+        XmlWriter writer{&output};
+        writer.writeNamespace(db, "db"_L1);
+        writer.writeNamespace(xlink, "xlink"_L1);
+        writer.writeStartElement(db, "article"_L1);
+
+        QByteArray fragment;
+        XmlWriter fragment_writer{&fragment};
+        fragment_writer.declareNamespaces(writer);
+
+        WHEN("The namespaces of the outer writer are declared to it") {
+            fragment_writer.writeStartElement(db, "link"_L1);
+            fragment_writer.writeAttribute(xlink, "href"_L1, "a.html"_L1);
+            fragment_writer.writeEndElement();
+            writer.writeRawData(fragment);
+            writer.writeEndElement();
+
+            THEN("It uses their prefixes without declaring them again") {
+                REQUIRE(fragment == "<db:link xlink:href=\"a.html\"/>");
+                REQUIRE(output == "<db:article xmlns:db=\"http://docbook.org/ns/docbook\" "
+                                  "xmlns:xlink=\"http://www.w3.org/1999/xlink\">"
+                                  "<db:link xlink:href=\"a.html\"/></db:article>");
+            }
+        }
+    }
+}
+
+SCENARIO("Flushing the output to a device", "[XmlWriter][Flushing]") {
+    GIVEN("A writer that writes to a device") {
+        QBuffer device;
+        REQUIRE(device.open(QIODevice::WriteOnly));
+        XmlWriter writer{&device};
+
+        constexpr qsizetype threshold = 64 * 1024;
+        writer.writeStartElement(QString(), "a"_L1);
+        // "<a>" and the text fill the buffer up to one byte below the threshold.
+        writer.writeCharacters(QString(threshold - 4, u'x'));
+
+        WHEN("Less than 64 KB of output is buffered") {
+            THEN("Nothing has been written to the device") {
+                REQUIRE(device.data().isEmpty());
+            }
+        }
+
+        WHEN("The buffered output reaches 64 KB") {
+            writer.writeCharacters("x"_L1);
+
+            THEN("All of it is written to the device") {
+                REQUIRE(device.data().size() == threshold);
+            }
+        }
+
+        WHEN("The document is ended") {
+            writer.writeCharacters("x"_L1);
+            writer.writeCharacters("y"_L1);
+            writer.writeEndDocument();
+
+            THEN("The remaining output is written to the device") {
+                REQUIRE(device.data() == "<a>" + QByteArray(threshold - 3, 'x') + "y</a>\n");
+            }
+        }
+    }
+}
@@ -0,0 +1,90 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <catch_conversions/qdoc_catch_conversions.h>
+
+#include <catch/catch.hpp>
+
+#include <qdoc/filesystem/directorywalker.h>
+
+#include <QTemporaryDir>
+#include <QFileInfo>
+#include <QDir>
+#include <QFile>
+#include <QIODeviceBase>
+
+static void create_files(const QString& root, const QStringList& relative_paths)
+{
+    for (const QString& relative_path : relative_paths) {
+        REQUIRE(QDir{root}.mkpath(QFileInfo{relative_path}.path()));
+        REQUIRE(QFile{root + "/" + relative_path}.open(QIODeviceBase::ReadWrite | QIODeviceBase::NewOnly));
+    }
+}
+
+static QStringList prefixed(const QString& root, const QStringList& relative_paths)
+{
+    QStringList paths;
+    for (const QString& relative_path : relative_paths)
+        paths.append(root + "/" + relative_path);
+    return paths;
+}
+
+SCENARIO("Collecting the files below a directory", "[WalkingDirectories][Directory][Path][Contents]") {
+    GIVEN("A directory tree containing files with different extensions") {
+        QTemporaryDir working_directory{};
+        REQUIRE(working_directory.isValid());
+        const QString root = QDir{working_directory.path()}.canonicalPath();
+
+        create_files(root, {
+            "b.cpp", "a.cpp", "a.h", "~backup.cpp",
+            "sub/z.cpp", "sub/deeper/y.cpp", "sub/deeper/y.txt",
+            "other/x.cpp", "other/x.qdoc", ".hidden/w.cpp"
+        });
+
+        WHEN("The files matching a name filter are collected") {
+            DirectoryWalker walker{"*.cpp *.qdoc", {}, {}};
+            QStringList files = walker.walk({ root }, DirectoryWalker::PathStyle::Canonical);
+
+            THEN("The files of each directory, sorted by name, precede those of its subdirectories, in sorted order") {
+                REQUIRE(files == prefixed(root, {
+                    "a.cpp", "b.cpp", "other/x.cpp", "other/x.qdoc",
+                    "sub/z.cpp", "sub/deeper/y.cpp"
+                }));
+            }
+        }
+
+        WHEN("The files are collected with some directories and files excluded") {
+            DirectoryWalker walker{"*.cpp", { root + "/sub" }, { root + "/b.cpp", root + "/other/x.cpp" }};
+            QStringList files = walker.walk({ root }, DirectoryWalker::PathStyle::Canonical);
+
+            THEN("The excluded directories are pruned and the excluded files are left out") {
+                REQUIRE(files == prefixed(root, { "a.cpp" }));
+            }
+        }
+
+        WHEN("The same directory tree is walked again") {
+            DirectoryWalker walker{"*.cpp *.qdoc", {}, {}};
+            QStringList first = walker.walk({ root }, DirectoryWalker::PathStyle::Canonical);
+            QStringList second = walker.walk({ root }, DirectoryWalker::PathStyle::Canonical);
+
+            THEN("The result is the same") {
+                REQUIRE(first == second);
+            }
+        }
+    }
+
+    GIVEN("A root directory that does not exist") {
+        QTemporaryDir working_directory{};
+        REQUIRE(working_directory.isValid());
+
+        WHEN("The files below it are collected") {
+            DirectoryWalker walker{"*.cpp", {}, {}};
+            QStringList files = walker.walk({ working_directory.path() + "/missing" },
+                                            DirectoryWalker::PathStyle::Canonical);
+
+            THEN("No files are found") {
+                REQUIRE(files.isEmpty());
+            }
+        }
+    }
+}
@@ -27,6 +27,7 @@ private slots:
     void chains_data();
     void chains();
     void merge();
+    void mergeLarge();
 
 private:
     void doWait(QProcess *cvt, int stage);
@@ -367,6 +368,69 @@ void tst_lconvert::merge()
         doCompare(&cvt, dataDir + "idxmerge.ts.out");
 }
 
+static void writeLargeTsFile(const QString &fileName, bool withGaps)
+{
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Text));
+    QTextStream out(&file);
+    out << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<!DOCTYPE TS>\n"
+           "<TS version=\"2.1\" language=\"de\">\n";
+    for (int c = 0; c < 100; ++c) {
+        out << "<context>\n    <name>Context" << c << "</name>\n";
+        for (int i = 0; i < 1000; ++i) {
+            if (withGaps && i % 10 == 7)
+                continue;
+            out << "    <message>\n"
+                << "        <location filename=\"file" << c << ".cpp\" line=\"" << 10 * i
+                << "\"/>\n"
+                << "        <source>Text " << c << ' ' << i << "</source>\n"
+                << "        <translation>Text " << c << ' ' << i << " (de)</translation>\n"
+                << "    </message>\n";
+        }
+        out << "</context>\n";
+    }
+    out << "</TS>\n";
+}
+
+void tst_lconvert::mergeLarge()
+{
+    // Merging a catalogue with 100000 messages, 10000 of which are new and
+    // have to be sorted in between the existing ones, must not take time
+    // quadratic in the number of messages. Rescanning or renumbering the
+    // catalogue for each insertion takes far longer than the budget.
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString base = dir.filePath("base.ts");
+    const QString add = dir.filePath("add.ts");
+    const QString result = dir.filePath("result.ts");
+    writeLargeTsFile(base, true);
+    writeLargeTsFile(add, false);
+    if (QTest::currentTestFailed())
+        return;
+
+    QElapsedTimer timer;
+    timer.start();
+    QProcess cvt;
+    cvt.start(lconvert, { base, add, "-o", result });
+    QVERIFY2(cvt.waitForFinished(120000), "Process hung");
+    QVERIFY2(cvt.exitStatus() == QProcess::NormalExit, "Process crashed");
+    QCOMPARE(cvt.exitCode(), 0);
+    QVERIFY2(timer.elapsed() < 15000,
+             qPrintable(u"Merging took %1 ms"_s.arg(timer.elapsed())));
+
+    QFile file(result);
+    QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::Text));
+    static const QRegularExpression location(uR"(<location filename="file(\d+)\.cpp" line="(\d+)"/>)"_s);
+    int expected = 0;
+    for (const QRegularExpressionMatch &match : location.globalMatch(QString::fromUtf8(file.readAll()))) {
+        const int c = match.captured(1).toInt();
+        const int line = match.captured(2).toInt();
+        QCOMPARE(c * 1000 + line / 10, expected);
+        ++expected;
+    }
+    QCOMPARE(expected, 100000);
+}
+
 QTEST_APPLESS_MAIN(tst_lconvert)
 
 #include "tst_lconvert.moc"
@@ -0,0 +1,20 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtCore>
+
+// The contexts are looked up in the AST, so they come before the missing include.
+class OnlyQDeclare
+{
+    Q_DECLARE_TR_FUNCTIONS(ONLY_Q)
+    QString c_tr = tr("context ONLY_Q. tr");
+    const char *c_noop = QT_TR_NOOP("context ONLY_Q. noop");
+};
+
+const char *c_before = QT_TRANSLATE_NOOP("scope", "before the include");
+
+#include "does_not_exist.h"
+
+// The preprocessor carries on after a missing include.
+const char *c_after = QT_TRANSLATE_NOOP("scope", "after the include");
+const char *c_after3[2] = QT_TRANSLATE_NOOP3("scope", "after the include, with comment", "comment");
@@ -0,0 +1,4 @@
+SOURCES += complete_include.cpp
+SOURCES += missing_include.cpp
+
+TRANSLATIONS = project.ts
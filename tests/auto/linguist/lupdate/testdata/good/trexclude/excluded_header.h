@@ -0,0 +1,14 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#ifndef EXCLUDED_HEADER_H
+#define EXCLUDED_HEADER_H
+
+#include <QtCore>
+
+inline QString excludedHeaderText()
+{
+    return QCoreApplication::translate("ExcludedHeader", "This message will not be collected");
+}
+
+#endif // EXCLUDED_HEADER_H
@@ -0,0 +1,9 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtCore>
+
+QString excludedSourceText()
+{
+    return QCoreApplication::translate("ExcludedSource", "This message will not be collected");
+}
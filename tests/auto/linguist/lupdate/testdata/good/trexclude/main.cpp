@@ -0,0 +1,17 @@
+// Copyright (C) 2024 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only
+
+#include <QtCore>
+
+// test TR_EXCLUDE with several patterns
+#include "included.cpp"
+#include "excluded_included.cpp"
+#include "excluded_header.h"
+#include "sub/helper.cpp"
+
+int main(int argc, char **argv)
+{
+    QCoreApplication app(argc, argv);
+    QString text = QCoreApplication::translate("Main", "message from main.cpp");
+    return 0;
+}
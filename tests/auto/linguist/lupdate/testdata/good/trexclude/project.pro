@@ -0,0 +1,7 @@
+SOURCES += main.cpp
+SOURCES += excluded_source.cpp
+HEADERS += excluded_header.h
+
+TR_EXCLUDE = $$PWD/excluded_*.cpp $$PWD/sub/* $$PWD/excluded_header.h
+
+TRANSLATIONS = project.ts
@@ -10,9 +10,12 @@
 #include <QtCore/QDir>
 #include <QtCore/QFile>
 #include <QtCore/QElapsedTimer>
+#include <QtCore/QProcess>
 #include <QtCore/private/qconfig_p.h>
 #include <QtCore/QSet>
+#include <QtCore/QTextStream>
 #include <QtCore/QSysInfo>
+#include <QtCore/QTemporaryDir>
 
 #include <QtTest/QtTest>
 #include <QtTools/private/qttools-config_p.h>
@@ -36,6 +39,11 @@ private slots:
     void cleanupTestCase();
     void good_data();
     void good();
+    void deepNamespaces();
+#if QT_CONFIG(clangcpp) && QT_CONFIG(widgets)
+    void clangFileCache_data();
+    void clangFileCache();
+#endif
 #if CHECK_SIMTEXTH
     void simtexth();
     void simtexth_data();
@@ -240,7 +248,7 @@ void tst_lupdate::good_data()
     QSet<QString> ignoredTests = {
         "lacksqobject_clang_parser"_L1, "parsecontexts_clang_parser"_L1, "parsecpp2_clang_parser"_L1,
         "parsecpp_clang_parser"_L1,     "prefix_clang_parser"_L1,        "preprocess_clang_parser"_L1,
-        "parsecpp_clang_only"_L1};
+        "parsecpp_clang_only"_L1,       "missinginclude_clang_only"_L1};
 
     // Add test rows for the "classic" lupdate
     for (const QString &dir : dirs) {
@@ -417,6 +425,164 @@ void tst_lupdate::good()
     }
 }
 
+static constexpr int DeepNamespaceHeaders = 40;
+static constexpr int DeepNamespaceDepth = 8;
+static constexpr int DeepNamespaceClasses = 25;
+
+// Writes DeepNamespaceHeaders headers that declare classes in namespaces
+// nested DeepNamespaceDepth levels deep, and a source file that defines a
+// member function with a tr() call for each of them, referring to the
+// classes through using directives and partially qualified names.
+static void writeDeepNamespaceSources(const QString &dir)
+{
+    QString scope;
+    for (int level = 0; level < DeepNamespaceDepth; ++level)
+        scope += u"N%1::"_s.arg(level);
+
+    QFile source(dir + "/main.cpp"_L1);
+    QVERIFY(source.open(QIODevice::WriteOnly | QIODevice::Text));
+    QTextStream sourceOut(&source);
+
+    for (int h = 0; h < DeepNamespaceHeaders; ++h) {
+        const QString headerName = u"header%1.h"_s.arg(h);
+        QFile header(dir + u'/' + headerName);
+        QVERIFY(header.open(QIODevice::WriteOnly | QIODevice::Text));
+        QTextStream out(&header);
+        for (int level = 0; level < DeepNamespaceDepth; ++level)
+            out << "namespace N" << level << " {\n";
+        for (int c = 0; c < DeepNamespaceClasses; ++c) {
+            out << "class C" << h << '_' << c << " : public QObject\n{\n"
+                << "    Q_OBJECT\npublic:\n    void f();\n};\n";
+        }
+        for (int level = 0; level < DeepNamespaceDepth; ++level)
+            out << "}\n";
+        sourceOut << "#include \"" << headerName << "\"\n";
+    }
+
+    sourceOut << "\nusing namespace N0::N1;\n\n";
+    for (int h = 0; h < DeepNamespaceHeaders; ++h) {
+        for (int c = 0; c < DeepNamespaceClasses; ++c) {
+            sourceOut << "void " << QStringView(scope).sliced(8) << 'C' << h << '_' << c
+                      << "::f()\n{\n    tr(\"message " << h << ' ' << c << "\");\n}\n";
+        }
+    }
+}
+
+void tst_lupdate::deepNamespaces()
+{
+    // Every tr() call is resolved against the same deeply nested scopes;
+    // doing so must not take time proportional to the depth and the number
+    // of included headers for each call.
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    writeDeepNamespaceSources(dir.path());
+    if (QTest::currentTestFailed())
+        return;
+
+    const QString tsFile = dir.filePath(u"project.ts"_s);
+    QProcess proc;
+    proc.setWorkingDirectory(dir.path());
+    proc.setProcessChannelMode(QProcess::MergedChannels);
+    const auto startTime = m_timer.elapsed();
+    proc.start(m_cmdLupdate, { u"-silent"_s, u"main.cpp"_s, u"-ts"_s, tsFile },
+               QIODevice::ReadWrite | QIODevice::Text);
+    QVERIFY2(proc.waitForStarted(), msgStartFailed(proc).constData());
+    if (!proc.waitForFinished(TIMEOUT)) {
+        const auto message = msgTimeout(proc);
+        proc.kill();
+        proc.waitForFinished(50);
+        QFAIL(message.constData());
+    }
+    const auto elapsed = m_timer.elapsed() - startTime;
+    const QByteArray output = proc.readAll();
+    QVERIFY2(proc.exitStatus() == QProcess::NormalExit, msgCrashed(proc, output).constData());
+    QVERIFY2(proc.exitCode() == 0, msgExitCode(proc, output).constData());
+
+    qInfo().noquote().nospace() << elapsed << "ms";
+
+    QFile file(tsFile);
+    QVERIFY2(file.open(QIODevice::ReadOnly | QIODevice::Text), qPrintable(tsFile));
+    const QString ts = QString::fromUtf8(file.readAll());
+    static const QRegularExpression context(uR"(<name>N0::N1::N2::N3::N4::N5::N6::N7::C(\d+)_(\d+)</name>)"_s);
+    QCOMPARE(ts.count(context), DeepNamespaceHeaders * DeepNamespaceClasses);
+}
+
+#if QT_CONFIG(clangcpp) && QT_CONFIG(widgets)
+void tst_lupdate::clangFileCache_data()
+{
+    QTest::addColumn<QString>("directory");
+
+    QTest::newRow("parsecpp") << u"parsecpp_clang_parser"_s;
+    QTest::newRow("parsecontexts") << u"parsecontexts_clang_parser"_s;
+    QTest::newRow("preprocess") << u"preprocess_clang_parser"_s;
+}
+
+// The clang-based parser shares the contents of the files it reads
+// between its worker threads. The result must not depend on that.
+void tst_lupdate::clangFileCache()
+{
+    if (QSysInfo::currentCpuArchitecture() == "arm64"_L1 && QSysInfo::kernelType() == "linux"_L1)
+        QSKIP("clangcpp tests are skipped on linux arm64, see also QTBUG-127751");
+    if (QSysInfo::kernelType() == "darwin"_L1)
+        QSKIP("clangcpp tests are skipped on macOS, see also QTBUG-130006 and QTBUG-130096");
+
+    QFETCH(QString, directory);
+
+    const QString dir = m_basePath + "good/"_L1 + directory;
+    QTemporaryDir outDir;
+    QVERIFY(outDir.isValid());
+
+    QFile file(dir + "/.qmake.cache"_L1);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.close();
+
+    auto runLupdate = [&](const QString &tsFile, bool useCache, QByteArray *output) {
+        QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+        if (useCache)
+            env.remove(u"LUPDATE_NO_FILE_CACHE"_s);
+        else
+            env.insert(u"LUPDATE_NO_FILE_CACHE"_s, u"1"_s);
+
+        QProcess proc;
+        proc.setProcessEnvironment(env);
+        proc.setWorkingDirectory(dir);
+        proc.setProcessChannelMode(QProcess::MergedChannels);
+        proc.start(m_cmdLupdate,
+                   { u"-silent"_s, u"project.pro"_s, u"-clang-parser"_s, u"-ts"_s, tsFile },
+                   QIODevice::ReadWrite | QIODevice::Text);
+        QVERIFY2(proc.waitForStarted(), msgStartFailed(proc).constData());
+        if (!proc.waitForFinished(TIMEOUT)) {
+            const auto message = msgTimeout(proc);
+            proc.kill();
+            proc.waitForFinished(50);
+            QFAIL(message.constData());
+        }
+        *output = proc.readAll();
+        QVERIFY2(proc.exitStatus() == QProcess::NormalExit, msgCrashed(proc, *output).constData());
+        QVERIFY2(proc.exitCode() == 0, msgExitCode(proc, *output).constData());
+    };
+
+    const QString cachedTs = outDir.filePath(u"cached.ts"_s);
+    const QString uncachedTs = outDir.filePath(u"uncached.ts"_s);
+    QByteArray cachedOutput;
+    QByteArray uncachedOutput;
+    runLupdate(cachedTs, true, &cachedOutput);
+    if (QTest::currentTestFailed())
+        return;
+    runLupdate(uncachedTs, false, &uncachedOutput);
+    if (QTest::currentTestFailed())
+        return;
+
+    QCOMPARE(cachedOutput, uncachedOutput);
+
+    QFile cached(cachedTs);
+    QVERIFY2(cached.open(QIODevice::ReadOnly), qPrintable(cachedTs));
+    QFile uncached(uncachedTs);
+    QVERIFY2(uncached.open(QIODevice::ReadOnly), qPrintable(uncachedTs));
+    QCOMPARE(cached.readAll(), uncached.readAll());
+}
+#endif
+
 #if CHECK_SIMTEXTH
 void tst_lupdate::simtexth()
 {
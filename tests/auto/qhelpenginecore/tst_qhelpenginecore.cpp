@@ -38,6 +38,9 @@ private slots:
     void filterAttributeSets();
     void files();
     void fileData();
+    void fileDataAfterRegistration();
+    void fileNameIndexes();
+    void outdatedRegistrations();
 
     void customValue();
     void setCustomValue();
@@ -355,6 +358,113 @@ void tst_QHelpEngineCore::fileData()
     QCOMPARE(s.readAll(), ts.readAll());
 }
 
+void tst_QHelpEngineCore::fileDataAfterRegistration()
+{
+    QHelpEngineCore help(m_colFile, 0);
+    help.setReadOnly(false);
+    QCOMPARE(help.setupData(), true);
+
+    const QUrl url("qthelp://trolltech.com.1.0.0.test/testFolder/test.html");
+    // No documentation has this namespace, so the file must be routed by its path.
+    const QUrl routedUrl("qthelp://trolltech.com.1.0.0.other/testFolder/test.html");
+    QVERIFY(!help.fileData(url).isEmpty());
+    QCOMPARE(help.findFile(routedUrl).authority(), QString("trolltech.com.1.0.0.test"));
+
+    QVERIFY(help.unregisterDocumentation("trolltech.com.1.0.0.test"));
+    QVERIFY(!help.registeredDocumentations().contains("trolltech.com.1.0.0.test"));
+    QVERIFY(help.fileData(url).isEmpty());
+    QVERIFY(help.fileData(routedUrl).isEmpty());
+
+    QVERIFY(help.registerDocumentation(m_path + "/data/test.qch"));
+    QVERIFY(help.registeredDocumentations().contains("trolltech.com.1.0.0.test"));
+    QVERIFY(!help.fileData(url).isEmpty());
+    QCOMPARE(help.findFile(routedUrl).authority(), QString("trolltech.com.1.0.0.test"));
+    QCOMPARE(help.fileData(routedUrl), help.fileData(url));
+}
+
+void tst_QHelpEngineCore::fileNameIndexes()
+{
+    {
+        QHelpEngineCore help(m_colFile, 0);
+        help.setReadOnly(false);
+        QCOMPARE(help.setupData(), true);
+        QVERIFY(!help.fileData(QUrl("qthelp://trolltech.com.1.0.0.test/testFolder/test.html"))
+                         .isEmpty());
+    }
+
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "testdb");
+        db.setDatabaseName(m_colFile);
+        QVERIFY(db.open());
+        QSqlQuery query(db);
+        QVERIFY(query.exec("SELECT Name FROM sqlite_master WHERE Type='index' "
+                           "AND (Name='FileNameIndex' OR Name='FolderNameIndex') "
+                           "ORDER BY Name"));
+        QStringList indexes;
+        while (query.next())
+            indexes.append(query.value(0).toString());
+        QCOMPARE(indexes, QStringList({ "FileNameIndex", "FolderNameIndex" }));
+
+        QVERIFY(query.exec("SELECT COUNT(*) FROM FileNameTable WHERE Name LIKE './%'"));
+        QVERIFY(query.next());
+        QCOMPARE(query.value(0).toInt(), 0);
+    }
+    QSqlDatabase::removeDatabase("testdb");
+}
+
+void tst_QHelpEngineCore::outdatedRegistrations()
+{
+    QStringList docs;
+    {
+        QHelpEngineCore help(m_colFile, 0);
+        help.setReadOnly(false);
+        QCOMPARE(help.setupData(), true);
+        docs = help.registeredDocumentations();
+    }
+
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "testdb");
+        db.setDatabaseName(m_colFile);
+        QVERIFY(db.open());
+        QSqlQuery query(db);
+        QVERIFY(query.exec("UPDATE TimeStampTable SET TimeStamp = '2000-01-01T00:00:00Z'"));
+        QVERIFY(query.numRowsAffected() > 0);
+    }
+    QSqlDatabase::removeDatabase("testdb");
+
+    {
+        QHelpEngineCore help(m_colFile, 0);
+        help.setReadOnly(false);
+        QSignalSpy spy(&help, &QHelpEngineCore::setupFinished);
+        QCOMPARE(help.setupData(), true);
+        QCOMPARE(spy.size(), 1);
+
+        // The collection is in use before the validation has finished.
+        const QUrl url("qthelp://trolltech.com.1.0.0.test/testFolder/test.html");
+        const QUrl routedUrl("qthelp://trolltech.com.1.0.0.other/testFolder/test.html");
+        QCOMPARE(help.findFile(routedUrl).authority(), QString("trolltech.com.1.0.0.test"));
+        const QByteArray data = help.fileData(url);
+        QVERIFY(!data.isEmpty());
+
+        QTRY_COMPARE(spy.size(), 2);
+        QCOMPARE(help.registeredDocumentations(), docs);
+        QCOMPARE(help.findFile(routedUrl).authority(), QString("trolltech.com.1.0.0.test"));
+        QCOMPARE(help.fileData(url), data);
+    }
+
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "testdb");
+        db.setDatabaseName(m_colFile);
+        QVERIFY(db.open());
+        QSqlQuery query(db);
+        QVERIFY(query.exec("SELECT COUNT(*) FROM TimeStampTable "
+                           "WHERE TimeStamp = '2000-01-01T00:00:00Z'"));
+        QVERIFY(query.next());
+        QCOMPARE(query.value(0).toInt(), 0);
+    }
+    QSqlDatabase::removeDatabase("testdb");
+}
+
 void tst_QHelpEngineCore::customValue()
 {
     QHelpEngineCore help(m_colFile, 0);